@@ -2,11 +2,13 @@
 #define _AVL_TREE_H_
 
 #include "Allocator.h"
+#include "Functional.h"
 #include "Iterator.h"
-#include "Stack.h"
+#include "NodePool.h"
 #include "String.h"
+#include "Utility.h"
 
-#include <set>
+#include <deque>
 #include <iostream>
 
 namespace MySTL{
@@ -15,24 +17,31 @@ namespace MySTL{
 		class avl_iter;
 	}
 	// class of avl tree
-	template<class T>
+	// Compare orders the values and may also compare a value with a lookup key,
+	// which is what lets map search by key alone
+	// NodeStorage is heap_node_storage or pooled_node_storage, see NodePool.h
+	template<class T, class Compare = MySTL::less<T>, class NodeStorage = MySTL::heap_node_storage>
 	class avl_tree{
 	private:
-		template<class T>
+		template<class T_>
 		friend class Detail::avl_iter;
 	private:
 		struct node{
 			T data_;
-			node *left_, *right_;
+			node *left_, *right_, *parent_;
 			size_t height_;
+			size_t weight_;// nodes in the subtree rooted here
 			typedef T value_type;
-			explicit node(T d = T(), node *l = 0, node *r = 0, size_t h = 1)
-				:data_(d), left_(l), right_(r), height_(h){}
+			typedef avl_tree tree_type;
+			explicit node(T d = T(), node *l = 0, node *r = 0, size_t h = 1, size_t w = 1)
+				:data_(d), left_(l), right_(r), parent_(0), height_(h), weight_(w){}
 		};
 
-		typedef MySTL::allocator<node> dataAllocator;
+		typedef MySTL::allocator<node> dataAllocator;// constructs and destroys in place
+		typedef typename NodeStorage::template storage<node> storage_type;
 	public:
 		typedef T value_type;
+		typedef Compare value_compare;
 		typedef Detail::avl_iter<node> const_iterator;
 		typedef const T& const_reference;
 		typedef size_t size_type;
@@ -40,6 +49,7 @@ namespace MySTL{
 	private:
 		node *root_;
 		size_t size_;
+		storage_type storage_;
 
 	public:
 		avl_tree() :root_(0), size_(0){};
@@ -47,23 +57,42 @@ namespace MySTL{
 		avl_tree& operator= (const avl_tree&) = delete;
 		~avl_tree();
 
-		void insert(const T& val);
+		MySTL::pair<const_iterator, bool> insert(const T& val);// points to the new value or the equal one already here
+		bool insert_equal(const T& val);// keeps duplicates
 		template<class Iterator>
 		void insert(Iterator first, Iterator last);
-		void erase(const T& val);
+		template<class K>
+		size_type erase(const K& key);// erases one value equal to key
+		template<class Iterator>
+		void assign_sorted(Iterator first, Iterator last);// replaces the values with an ascending range in O(n)
+		void unite(avl_tree& other);// moves the values of other that are not here into this tree
+		void intersect(avl_tree& other);// keeps the values found in both trees
+		void compact();// moves the nodes into fresh storage in in-order sequence
 
 		size_t height()const { return getHeight(root_); }
 		size_t size()const{ return size_; }
 		bool empty() const{ return root_ == 0; }
-		const_iterator root() const{ return const_iterator(root_, this); }
+		const_iterator root() const{ return const_iterator(root_); }
 
 		const_iterator cbegin() const{ return find_min(); }
-		const_iterator cend() const { return const_iterator(0, this); }
+		const_iterator cend() const { return const_iterator(); }
 
 		const_iterator find_min()const;
 		const_iterator find_max()const;
-		const_iterator find(const T& val)const;
-		
+		template<class K>
+		const_iterator find(const K& key)const;
+		template<class K>
+		const_iterator lower_bound(const K& key)const;
+		template<class K>
+		const_iterator upper_bound(const K& key)const;
+		template<class K>
+		MySTL::pair<const_iterator, const_iterator> equal_range(const K& key)const{
+			return MySTL::make_pair(lower_bound(key), upper_bound(key));
+		}
+		const_iterator select(size_type k)const;// the k-th smallest value, counting from 0
+		template<class K>
+		size_type rank(const K& key)const;// number of values less than key
+
 		void print_preorder(const string& delim = " ", std::ostream& os = std::cout)const;
 		void print_inorder(const string& delim = " ", std::ostream& os = std::cout)const;
 		void print_postorder(const string& delim = " ", std::ostream& os = std::cout)const;
@@ -76,13 +105,25 @@ namespace MySTL{
 		node *singleRightRightRotate(node * k2);
 
 	private:
-		void insert_elem(const T& val, node *&p);
-		void erase_elem(const T& val, node *&p);
+		static bool less(const T& lhs, const T& rhs){ return Compare()(lhs, rhs); }
+		bool insert_elem(const T& val, node *&p, bool unique, node *&pos);
+		template<class K>
+		bool erase_elem(const K& key, node *&p);
+		node *rebalance(node *p);
+		template<class Iterator>
+		node *build_sorted(Iterator& first, size_type n);
+		node *join(node *l, node *mid, node *r);
+		node *join2(node *l, node *r);
+		node *split(node *p, const T& val, node *&l, node *&r);
+		node *remove_min(node *p, node *&min);
+		node *unite_aux(node *p, node *q);
+		node *intersect_aux(node *p, node *q);
+		node *compact_aux(node *p, storage_type& fresh);
 		void destroyAndDeallocateAllNodes(node *p);
 		size_t getHeight(const node *p)const{ return p == 0 ? 0 : p->height_; }
+		size_t getWeight(const node *p)const{ return p == 0 ? 0 : p->weight_; }
 		const_iterator find_min_aux(const node *ptr)const;
 		const_iterator find_max_aux(const node *ptr)const;
-		const_iterator find_aux(const T& val, const node *ptr)const;
 		void print_preorder_aux(const string& delim, std::ostream& os, const node *ptr)const;
 		void print_inorder_aux(const string& delim, std::ostream& os, const node *ptr)const;
 		void print_postorder_aux(const string& delim, std::ostream& os, const node *ptr)const;
@@ -90,41 +131,38 @@ namespace MySTL{
 	namespace Detail{
 		// class of avl tree iterator
 		template<class T>// T = node
+		// a node pointer only, ++ follows the parent pointers
 		class avl_iter
-			: public iterator<forward_iterator_tag, typename avl_tree<typename T::value_type>::value_type>{
+			: public iterator<forward_iterator_tag, typename T::tree_type::value_type>{
 		
 		private:
-			template<class T>
-			friend class avl_tree;
+			template<class T_, class Compare_, class NodeStorage_>
+			friend class MySTL::avl_tree;
 		private:
-			typedef typename avl_tree<typename T::value_type>::const_reference const_reference;
-			typedef typename const T::value_type *const_pointer;
-			typedef const avl_tree<typename T::value_type> *cntrPtr;
+			typedef typename T::tree_type::const_reference const_reference;
+			typedef const typename T::value_type *const_pointer;
 
 		private:
 			const T *ptr_;
-			cntrPtr container_;
-			stack<const T *> parent_;
-			std::set<const T *> visited_;
 
 		public:
-			avl_iter(const T *ptr, cntrPtr container);
+			explicit avl_iter(const T *ptr = 0) :ptr_(ptr){}
 
 			operator const T*()const{ return ptr_; }
 			const_reference operator*()const{ return ptr_->data_; }
 			const_pointer operator ->()const{ return &(operator*()); }
 
-			avl_iter left()const{ return avl_iter(ptr_->left_, container_); }
-			avl_iter right()const{ return avl_iter(ptr_->right_, container_); }
+			avl_iter left()const{ return avl_iter(ptr_->left_); }
+			avl_iter right()const{ return avl_iter(ptr_->right_); }
 
 			avl_iter& operator ++();
 			avl_iter operator ++(int);
 
 		public:
-			template<class T>
-			friend bool operator ==(const avl_iter<T>& it1, const avl_iter<T>& it2);
-			template<class T>
-			friend bool operator !=(const avl_iter<T>& it1, const avl_iter<T>& it2);
+			template<class T_>
+			friend bool operator ==(const avl_iter<T_>& it1, const avl_iter<T_>& it2);
+			template<class T_>
+			friend bool operator !=(const avl_iter<T_>& it1, const avl_iter<T_>& it2);
 		};// end of avl_iter
 	}
 }
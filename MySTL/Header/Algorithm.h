@@ -2,11 +2,15 @@
 #define _ALGORITHM_H_
 
 #include <cstring>
+#include <iterator>
+#include <new>
+#include <type_traits>
 #include <utility>
 
 #include "Allocator.h"
 #include "Functional.h"
 #include "Iterator.h"
+#include "Simd.h"
 #include "TypeTraits.h"
 #include "Utility.h"
 
@@ -72,124 +76,212 @@ namespace MySTL{
 		return (comp(a, b)) ? b : a;
 	}
 
-	//********** [make_heap] ***************
-	//********* [Algorithm Complexity: O(N)] ****************
-	template<class RandomAccessIterator, class Compare>
-	//heap㷨
-	static void up(RandomAccessIterator first, RandomAccessIterator last,
-		RandomAccessIterator head, Compare comp){//1.[first, last], 2.headr points the header of the heap
-		if (first != last){
-			int index = last - head;
-			auto parentIndex = (index - 1) / 2;
-			for (auto cur = last; parentIndex >= 0 && cur != head; parentIndex = (index - 1) / 2){
-				auto parent = head + parentIndex;//get parent
-				if (comp(*parent, *cur))
-					MySTL::swap(*parent, *cur);
-				cur = parent;
-				index = cur - head;
-			}
-		}
-	}
-
-	template<class RandomAccessIterator, class Compare>
-	//heap½㷨
-	static void down(RandomAccessIterator first, RandomAccessIterator last,
-		RandomAccessIterator head, Compare comp){//1.[first, last], 2.headr points the header of the heap
-		if (first != last){
-			auto index = first - head;
-			auto leftChildIndex = index * 2 + 1;
-			for (auto cur = first; leftChildIndex < (last - head + 1) && cur < last; leftChildIndex = index * 2 + 1){
-				auto child = head + leftChildIndex;//get the left child
-				if ((child + 1) <= last && *(child + 1) > *child)//cur has a right child
-					child = child + 1;
-				if (comp(*cur, *child))
-					MySTL::swap(*cur, *child);
-				cur = child;
-				index = cur - head;
+	//********** [heap] ***************
+	//the heap algorithms take an optional Arity, MySTL::push_heap<4>(first, last, comp)
+	//keeps a 4-ary heap whose children D * i + 1 ... D * i + D of item i share a cache
+	//line, so the heap is half as deep as a binary one. Items are moved into a hole, one
+	//move per level instead of a swap
+	namespace {
+		template<size_t Arity, class RandomAccessIterator, class Distance, class T, class Compare>
+		void heap_sift_up(RandomAccessIterator head, Distance hole, Distance top, T val, Compare comp){
+			Distance parent = (hole - 1) / static_cast<Distance>(Arity);
+			while (hole > top && comp(*(head + parent), val)){
+				*(head + hole) = std::move(*(head + parent));
+				hole = parent;
+				parent = (hole - 1) / static_cast<Distance>(Arity);
+			}
+			*(head + hole) = std::move(val);
+		}
+
+		//the greatest of the children from child on, len is the size of the heap
+		template<size_t Arity, class RandomAccessIterator, class Distance, class Compare>
+		Distance heap_greatest_child(RandomAccessIterator head, Distance child, Distance len, Compare comp){
+			const Distance last = len - child < static_cast<Distance>(Arity) ? len : child + static_cast<Distance>(Arity);
+			Distance greatest = child;
+			while (++child < last){
+				if (comp(*(head + greatest), *(head + child)))
+					greatest = child;
 			}
+			return greatest;
+		}
+
+		//val goes down from hole until no child is greater
+		template<size_t Arity, class RandomAccessIterator, class Distance, class T, class Compare>
+		void heap_sift_down(RandomAccessIterator head, Distance hole, Distance len, T val, Compare comp){
+			for (Distance child = hole * static_cast<Distance>(Arity) + 1; child < len;
+				child = hole * static_cast<Distance>(Arity) + 1){
+				child = heap_greatest_child<Arity>(head, child, len, comp);
+				if (!comp(val, *(head + child)))
+					break;
+				*(head + hole) = std::move(*(head + child));
+				hole = child;
+			}
+			*(head + hole) = std::move(val);
+		}
+
+		//Floyd's sift: the hole goes down to a leaf along the greatest children without
+		//looking at val, then val goes up from there. val comes from the bottom of the heap
+		//when popping and nearly always belongs near a leaf, so this saves a compare a level
+		template<size_t Arity, class RandomAccessIterator, class Distance, class T, class Compare>
+		void heap_sift_down_floyd(RandomAccessIterator head, Distance hole, Distance len, T val, Compare comp){
+			const Distance top = hole;
+			for (Distance child = hole * static_cast<Distance>(Arity) + 1; child < len;
+				child = hole * static_cast<Distance>(Arity) + 1){
+				child = heap_greatest_child<Arity>(head, child, len, comp);
+				*(head + hole) = std::move(*(head + child));
+				hole = child;
+			}
+			heap_sift_up<Arity>(head, hole, top, std::move(val), comp);
 		}
 	}
 
-	template <class RandomAccessIterator>
-	void make_heap(RandomAccessIterator first, RandomAccessIterator last){
-		MySTL::make_heap(first, last,
-			typename MySTL::less<TinySTL::iterator_traits<RandomAccessIterator>::value_type>());
+	//********** [make_heap] ***************
+	//********* [Algorithm Complexity: O(N)] ****************
+	template <size_t Arity, class RandomAccessIterator, class Compare>
+	void make_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp){
+		static_assert(Arity >= 2, "a heap needs 2 children a node at least");
+		typedef typename iterator_traits<RandomAccessIterator>::value_type value_type;
+		const auto len = last - first;
+		if (len < 2)
+			return;
+		for (auto parent = (len - 2) / static_cast<decltype(len)>(Arity); ; --parent){
+			value_type val = std::move(*(first + parent));
+			heap_sift_down<Arity>(first, parent, len, std::move(val), comp);
+			if (parent == 0)
+				return;
+		}
 	}
 
 	template <class RandomAccessIterator, class Compare>
 	void make_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp){
-		const auto range = last - first;
-		for (auto cur = first + range / 2 - 1; cur >= first; --cur){
-			MySTL::down(cur, last - 1, first, comp);
-			if (cur == first) return;
-		}
+		MySTL::make_heap<2>(first, last, comp);
+	}
+
+	template <size_t Arity, class RandomAccessIterator>
+	void make_heap(RandomAccessIterator first, RandomAccessIterator last){
+		MySTL::make_heap<Arity>(first, last,
+			MySTL::less<typename MySTL::iterator_traits<RandomAccessIterator>::value_type>());
 	}
 
-	//********* [push_heap] ***************
-	//********* [Algorithm Complexity: O(lgN)] ****************
 	template <class RandomAccessIterator>
-	void push_heap(RandomAccessIterator first, RandomAccessIterator last){
-		MySTL::push_heap(first, last,
+	void make_heap(RandomAccessIterator first, RandomAccessIterator last){
+		MySTL::make_heap<2>(first, last,
 			MySTL::less<typename MySTL::iterator_traits<RandomAccessIterator>::value_type>());
 	}
 
+	//********* [push_heap] ***************
+	//********* [Algorithm Complexity: O(lgN)] ****************
+	template <size_t Arity, class RandomAccessIterator, class Compare>
+	void push_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp){
+		typedef typename iterator_traits<RandomAccessIterator>::value_type value_type;
+		const auto len = last - first;
+		if (len < 2)
+			return;
+		value_type val = std::move(*(last - 1));
+		heap_sift_up<Arity>(first, len - 1, static_cast<decltype(len)>(0), std::move(val), comp);
+	}
+
 	template <class RandomAccessIterator, class Compare>
 	void push_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp){
-		MySTL::up(first, last - 1, first, comp);
+		MySTL::push_heap<2>(first, last, comp);
+	}
+
+	template <size_t Arity, class RandomAccessIterator>
+	void push_heap(RandomAccessIterator first, RandomAccessIterator last){
+		MySTL::push_heap<Arity>(first, last,
+			MySTL::less<typename MySTL::iterator_traits<RandomAccessIterator>::value_type>());
 	}
 
-	//********* [pop_heap] ***************
-	//********* [Algorithm Complexity: O(lgN)] ****************
 	template <class RandomAccessIterator>
-	void pop_heap(RandomAccessIterator first, RandomAccessIterator last){
-		MySTL::pop_heap(first, last,
+	void push_heap(RandomAccessIterator first, RandomAccessIterator last){
+		MySTL::push_heap<2>(first, last,
 			MySTL::less<typename MySTL::iterator_traits<RandomAccessIterator>::value_type>());
 	}
 
+	//********* [pop_heap] ***************
+	//********* [Algorithm Complexity: O(lgN)] ****************
+	template <size_t Arity, class RandomAccessIterator, class Compare>
+	void pop_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp){
+		typedef typename iterator_traits<RandomAccessIterator>::value_type value_type;
+		const auto len = last - first;
+		if (len < 2)
+			return;
+		value_type val = std::move(*(last - 1));
+		*(last - 1) = std::move(*first);
+		heap_sift_down_floyd<Arity>(first, static_cast<decltype(len)>(0), len - 1, std::move(val), comp);
+	}
+
 	template <class RandomAccessIterator, class Compare>
 	void pop_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp){
-		MySTL::swap(*first, *(last - 1));
-		if (last - first >= 2)
-			MySTL::down(first, last - 2, first, comp);
+		MySTL::pop_heap<2>(first, last, comp);
+	}
+
+	template <size_t Arity, class RandomAccessIterator>
+	void pop_heap(RandomAccessIterator first, RandomAccessIterator last){
+		MySTL::pop_heap<Arity>(first, last,
+			MySTL::less<typename MySTL::iterator_traits<RandomAccessIterator>::value_type>());
 	}
 
-	//********* [sort_heap] ***************
-	//********* [Algorithm Complexity: O(N)] ****************
 	template <class RandomAccessIterator>
-	void sort_heap(RandomAccessIterator first, RandomAccessIterator last){
-		return MySTL::sort_heap(first, last,
+	void pop_heap(RandomAccessIterator first, RandomAccessIterator last){
+		MySTL::pop_heap<2>(first, last,
 			MySTL::less<typename MySTL::iterator_traits<RandomAccessIterator>::value_type>());
 	}
 
+	//********* [sort_heap] ***************
+	//********* [Algorithm Complexity: O(NlgN)] ****************
+	template <size_t Arity, class RandomAccessIterator, class Compare>
+	void sort_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp){
+		for (; last - first > 1; --last)
+			MySTL::pop_heap<Arity>(first, last, comp);
+	}
+
 	template <class RandomAccessIterator, class Compare>
 	void sort_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp){
-		for (auto cur = last; cur != first; --cur){
-			MySTL::pop_heap(first, cur, comp);
-		}
+		MySTL::sort_heap<2>(first, last, comp);
+	}
+
+	template <size_t Arity, class RandomAccessIterator>
+	void sort_heap(RandomAccessIterator first, RandomAccessIterator last){
+		MySTL::sort_heap<Arity>(first, last,
+			MySTL::less<typename MySTL::iterator_traits<RandomAccessIterator>::value_type>());
 	}
 
-	//********* [is_heap] ***************
-	//********* [Algorithm Complexity: O(N)] ****************
 	template <class RandomAccessIterator>
-	bool is_heap(RandomAccessIterator first, RandomAccessIterator last){
-		return MySTL::is_heap(first, last,
+	void sort_heap(RandomAccessIterator first, RandomAccessIterator last){
+		MySTL::sort_heap<2>(first, last,
 			MySTL::less<typename MySTL::iterator_traits<RandomAccessIterator>::value_type>());
 	}
 
-	template <class RandomAccessIterator, class Compare>
+	//********* [is_heap] ***************
+	//********* [Algorithm Complexity: O(N)] ****************
+	template <size_t Arity, class RandomAccessIterator, class Compare>
 	bool is_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp){
-		const auto range = last - first;
-		auto index = range / 2 - 1;
-		for (auto cur = first + range / 2 - 1; cur >= first; --cur, --index){
-			if (*(first + (index * 2 + 1)) > *cur ||//left child > cur
-				((first + (index * 2 + 2)) <= last && *(first + (index * 2 + 2)) > *cur))//right child > cur
+		const auto len = last - first;
+		for (decltype(last - first) child = 1; child < len; ++child){
+			if (comp(*(first + (child - 1) / static_cast<decltype(len)>(Arity)), *(first + child)))//child > parent
 				return false;
-			if (cur == first)
-				break;
 		}
 		return true;
 	}
 
+	template <class RandomAccessIterator, class Compare>
+	bool is_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp){
+		return MySTL::is_heap<2>(first, last, comp);
+	}
+
+	template <size_t Arity, class RandomAccessIterator>
+	bool is_heap(RandomAccessIterator first, RandomAccessIterator last){
+		return MySTL::is_heap<Arity>(first, last,
+			MySTL::less<typename MySTL::iterator_traits<RandomAccessIterator>::value_type>());
+	}
+
+	template <class RandomAccessIterator>
+	bool is_heap(RandomAccessIterator first, RandomAccessIterator last){
+		return MySTL::is_heap<2>(first, last,
+			MySTL::less<typename MySTL::iterator_traits<RandomAccessIterator>::value_type>());
+	}
+
 	//********** [all_of] *************************
 	//********* [Algorithm Complexity: O(N)] ****************
 	template <class InputIterator, class UnaryPredicate>
@@ -232,15 +324,61 @@ namespace MySTL{
 		return fn;
 	}
 
+	//********** [simd dispatch] *************************
+	//find, count, mismatch, equal and search over pointers to integers (or enums) use the
+	//SIMD kernels of Simd.h, such items are equal exactly when their bytes are
+	namespace {
+		template<class Iterator>
+		struct is_simd_range : std::false_type{};
+		template<class T>
+		struct is_simd_range<T *> : std::integral_constant<bool,
+			(std::is_integral<T>::value || std::is_enum<T>::value) &&
+			(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)>{};
+
+		//val is looked for in [first, last) by its bytes
+		template<class Iterator, class T>
+		struct is_simd_find : std::integral_constant<bool, is_simd_range<Iterator>::value &&
+			(std::is_integral<T>::value ||
+			std::is_same<T, typename std::remove_cv<typename std::remove_pointer<Iterator>::type>::type>::value)>{};
+
+		//two ranges of the same items
+		template<class Iterator1, class Iterator2>
+		struct is_simd_compare : std::integral_constant<bool, is_simd_range<Iterator1>::value &&
+			std::is_same<typename std::remove_cv<typename std::remove_pointer<Iterator1>::type>::type,
+			typename std::remove_cv<typename std::remove_pointer<Iterator2>::type>::type>::value>{};
+
+		//val as an item, false if no item can equal it (say 300 in a range of char)
+		template<class Item, class T>
+		bool simd_needle(const T& val, Item& item){
+			item = static_cast<Item>(val);
+			return item == val;
+		}
+	}
+
 	//********** [find] *************************
 	//********* [Algorithm Complexity: O(N)] ****************
+	namespace {
+		template <class InputIterator, class T>
+		InputIterator find_aux(InputIterator first, InputIterator last, const T& val, std::false_type){
+			for (; first != last; ++first){
+				if (*first == val)
+					break;
+			}
+			return first;
+		}
+
+		template <class Pointer, class T>
+		Pointer find_aux(Pointer first, Pointer last, const T& val, std::true_type){
+			typename iterator_traits<Pointer>::value_type item;
+			if (!simd_needle(val, item))
+				return last;
+			return first + Detail::simd_find(first, last - first, static_cast<uint64_t>(item), sizeof(item));
+		}
+	}
+
 	template <class InputIterator, class T>
 	InputIterator find(InputIterator first, InputIterator last, const T& val){
-		for (; first != last; ++first){
-			if (*first == val)
-				break;
-		}
-		return first;
+		return find_aux(first, last, val, is_simd_find<InputIterator, T>());
 	}
 
 	//********** [find_if] *************************
@@ -339,8 +477,8 @@ namespace MySTL{
 	//********* [Algorithm Complexity: O(N)] ****************
 	template <class ForwardIterator>
 	ForwardIterator adjacent_find(ForwardIterator first, ForwardIterator last){
-		return TinySTL::adjacent_find(first, last,
-			equal_to<iterator_traits<typename ForwardIterator>::value_type>());
+		return MySTL::adjacent_find(first, last,
+			equal_to<typename iterator_traits<ForwardIterator>::value_type>());
 	}
 
 	template <class ForwardIterator, class BinaryPredicate>
@@ -354,15 +492,32 @@ namespace MySTL{
 
 	//********** [count] ******************************
 	//********* [Algorithm Complexity: O(N)] ****************
+	namespace {
+		template <class InputIterator, class T>
+		typename iterator_traits<InputIterator>::difference_type
+			count_aux(InputIterator first, InputIterator last, const T& val, std::false_type){
+			typename iterator_traits<InputIterator>::difference_type n = 0;
+			for (; first != last; ++first){
+				if (*first == val)
+					++n;
+			}
+			return n;
+		}
+
+		template <class Pointer, class T>
+		typename iterator_traits<Pointer>::difference_type
+			count_aux(Pointer first, Pointer last, const T& val, std::true_type){
+			typename iterator_traits<Pointer>::value_type item;
+			if (!simd_needle(val, item))
+				return 0;
+			return Detail::simd_count(first, last - first, static_cast<uint64_t>(item), sizeof(item));
+		}
+	}
+
 	template <class InputIterator, class T>
 	typename iterator_traits<InputIterator>::difference_type
 		count(InputIterator first, InputIterator last, const T& val){
-		typename iterator_traits<InputIterator>::difference_type n = 0;
-		for (; first != last; ++first){
-			if (*first == val)
-				++n;
-		}
-		return n;
+		return count_aux(first, last, val, is_simd_find<InputIterator, T>());
 	}
 
 	//********** [count_if] ******************************
@@ -380,14 +535,30 @@ namespace MySTL{
 
 	//********** [mismatch] ******************************
 	//********* [Algorithm Complexity: O(N)] ****************
+	namespace {
+		template <class InputIterator1, class InputIterator2>
+		pair<InputIterator1, InputIterator2>
+			mismatch_aux(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, std::false_type){
+			for (; first1 != last1; ++first1, ++first2){
+				if (*first1 != *first2)
+					break;
+			}
+			return MySTL::make_pair(first1, first2);
+		}
+
+		template <class Pointer1, class Pointer2>
+		pair<Pointer1, Pointer2>
+			mismatch_aux(Pointer1 first1, Pointer1 last1, Pointer2 first2, std::true_type){
+			const size_t width = sizeof(*first1);
+			const auto n = Detail::simd_mismatch(first1, first2, (last1 - first1) * width) / width;
+			return MySTL::make_pair(first1 + n, first2 + n);
+		}
+	}
+
 	template <class InputIterator1, class InputIterator2>
 	pair<InputIterator1, InputIterator2>
 		mismatch(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2){
-		for (; first1 != last1; ++first1, ++first2){
-			if (*first1 != *first2)
-				break;
-		}
-		return MySTL::make_pair(first1, first2);
+		return mismatch_aux(first1, last1, first2, is_simd_compare<InputIterator1, InputIterator2>());
 	}
 
 	template <class InputIterator1, class InputIterator2, class BinaryPredicate>
@@ -403,12 +574,6 @@ namespace MySTL{
 	
 	//********** [equal] ******************************
 	//********* [Algorithm Complexity: O(N)] ****************
-	template <class InputIterator1, class InputIterator2>
-	bool equal(InputIterator1 first1, InputIterator1 last1,
-		InputIterator2 first2){
-		return TinySTL::equal(first1, last1, first2, TinySTL::equal_to<typename TinySTL::iterator_traits<InputIterator1>::value_type>());
-	}
-
 	template <class InputIterator1, class InputIterator2, class BinaryPredicate>
 	bool equal(InputIterator1 first1, InputIterator1 last1,
 		InputIterator2 first2, BinaryPredicate pred){
@@ -419,6 +584,25 @@ namespace MySTL{
 		return true;
 	}
 
+	namespace {
+		template <class InputIterator1, class InputIterator2>
+		bool equal_aux(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, std::false_type){
+			return MySTL::equal(first1, last1, first2, MySTL::equal_to<typename MySTL::iterator_traits<InputIterator1>::value_type>());
+		}
+
+		template <class Pointer1, class Pointer2>
+		bool equal_aux(Pointer1 first1, Pointer1 last1, Pointer2 first2, std::true_type){
+			const size_t bytes = (last1 - first1) * sizeof(*first1);
+			return Detail::simd_mismatch(first1, first2, bytes) == bytes;
+		}
+	}
+
+	template <class InputIterator1, class InputIterator2>
+	bool equal(InputIterator1 first1, InputIterator1 last1,
+		InputIterator2 first2){
+		return equal_aux(first1, last1, first2, is_simd_compare<InputIterator1, InputIterator2>());
+	}
+
 	//********** [is_permutation] ******************************
 	//********* [Algorithm Complexity: O(N*N)] ****************
 	template <class ForwardIterator1, class ForwardIterator2>
@@ -450,13 +634,6 @@ namespace MySTL{
 
 	//********** [search] ******************************
 	//********* [Algorithm Complexity: O(N*N)] ****************
-	template <class ForwardIterator1, class ForwardIterator2>
-	ForwardIterator1 search(ForwardIterator1 first1, ForwardIterator1 last1,
-		ForwardIterator2 first2, ForwardIterator2 last2){
-		return MySTL::search(first1, last1, first2, last2,
-			MySTL::equal_to<typename MySTL::iterator_traits<ForwardIterator1>::value_type>());
-	}
-
 	template <class ForwardIterator1, class ForwardIterator2, class BinaryPredicate>
 	ForwardIterator1 search(ForwardIterator1 first1, ForwardIterator1 last1,
 		ForwardIterator2 first2, ForwardIterator2 last2,
@@ -481,6 +658,219 @@ namespace MySTL{
 		return last1;
 	}
 
+	namespace {
+		template <class ForwardIterator1, class ForwardIterator2>
+		ForwardIterator1 search_aux(ForwardIterator1 first1, ForwardIterator1 last1,
+			ForwardIterator2 first2, ForwardIterator2 last2, std::false_type){
+			return MySTL::search(first1, last1, first2, last2,
+				MySTL::equal_to<typename MySTL::iterator_traits<ForwardIterator1>::value_type>());
+		}
+
+		//jump between the places of the first item of the pattern, then compare the rest
+		template <class Pointer1, class Pointer2>
+		Pointer1 search_aux(Pointer1 first1, Pointer1 last1, Pointer2 first2, Pointer2 last2, std::true_type){
+			const size_t width = sizeof(*first1);
+			const auto len2 = last2 - first2;
+			if (len2 == 0)
+				return first1;
+			const uint64_t head = static_cast<uint64_t>(*first2);
+			while (last1 - first1 >= len2){
+				const size_t candidates = (last1 - first1) - len2 + 1;
+				const size_t i = Detail::simd_find(first1, candidates, head, width);
+				if (i == candidates)
+					break;
+				first1 += i;
+				const size_t rest = (len2 - 1) * width;
+				if (Detail::simd_mismatch(first1 + 1, first2 + 1, rest) == rest)
+					return first1;
+				++first1;
+			}
+			return last1;
+		}
+	}
+
+	template <class ForwardIterator1, class ForwardIterator2>
+	ForwardIterator1 search(ForwardIterator1 first1, ForwardIterator1 last1,
+		ForwardIterator2 first2, ForwardIterator2 last2){
+		return search_aux(first1, last1, first2, last2, is_simd_compare<ForwardIterator1, ForwardIterator2>());
+	}
+
+	//********** [simd arithmetic] *************************
+	//min_element, max_element, accumulate and reduce over pointers to these numbers use
+	//the kernels of Simd.h when the order or the sum is the plain one
+	namespace {
+		template<class Iterator>
+		struct simd_number{ typedef void type; };
+		template<class T>
+		struct simd_number<T *>{ typedef typename std::remove_cv<T>::type type; };
+
+		template<class Iterator, class Compare>
+		struct is_simd_order : std::integral_constant<bool,
+			std::is_same<Compare, less<typename simd_number<Iterator>::type>>::value &&
+			(std::is_same<typename simd_number<Iterator>::type, int32_t>::value ||
+			std::is_same<typename simd_number<Iterator>::type, int64_t>::value ||
+			std::is_same<typename simd_number<Iterator>::type, float>::value ||
+			std::is_same<typename simd_number<Iterator>::type, double>::value)>{};
+
+		//Exact says the sum must not depend on the order of the adds
+		template<class Iterator, class T, bool Exact>
+		struct is_simd_sum : std::integral_constant<bool,
+			std::is_same<typename simd_number<Iterator>::type, T>::value &&
+			(std::is_same<T, int32_t>::value || std::is_same<T, uint32_t>::value ||
+			std::is_same<T, int64_t>::value || std::is_same<T, uint64_t>::value ||
+			(!Exact && (std::is_same<T, float>::value || std::is_same<T, double>::value)))>{};
+	}
+
+	//********** [min_element] ******************************
+	//********* [Algorithm Complexity: O(N)] ****************
+	namespace {
+		template<class ForwardIterator, class Compare>
+		ForwardIterator min_element_aux(ForwardIterator first, ForwardIterator last, Compare comp, std::false_type){
+			if (first == last)
+				return last;
+			ForwardIterator smallest = first;
+			while (++first != last){
+				if (comp(*first, *smallest))
+					smallest = first;
+			}
+			return smallest;
+		}
+
+		template<class Pointer, class Compare>
+		Pointer min_element_aux(Pointer first, Pointer last, Compare comp, std::true_type){
+			if (first == last)
+				return last;
+			const size_t i = Detail::simd_min_index(first, last - first);
+			if (i == Detail::SIMD_NO_INDEX)//NaN, keep the order of comp
+				return min_element_aux(first, last, comp, std::false_type());
+			return first + i;
+		}
+	}
+
+	template<class ForwardIterator, class Compare>
+	ForwardIterator min_element(ForwardIterator first, ForwardIterator last, Compare comp){
+		return min_element_aux(first, last, comp, is_simd_order<ForwardIterator, Compare>());
+	}
+
+	template<class ForwardIterator>
+	ForwardIterator min_element(ForwardIterator first, ForwardIterator last){
+		return MySTL::min_element(first, last, less<typename iterator_traits<ForwardIterator>::value_type>());
+	}
+
+	//********** [max_element] ******************************
+	//********* [Algorithm Complexity: O(N)] ****************
+	namespace {
+		template<class ForwardIterator, class Compare>
+		ForwardIterator max_element_aux(ForwardIterator first, ForwardIterator last, Compare comp, std::false_type){
+			if (first == last)
+				return last;
+			ForwardIterator largest = first;
+			while (++first != last){
+				if (comp(*largest, *first))
+					largest = first;
+			}
+			return largest;
+		}
+
+		template<class Pointer, class Compare>
+		Pointer max_element_aux(Pointer first, Pointer last, Compare comp, std::true_type){
+			if (first == last)
+				return last;
+			const size_t i = Detail::simd_max_index(first, last - first);
+			if (i == Detail::SIMD_NO_INDEX)
+				return max_element_aux(first, last, comp, std::false_type());
+			return first + i;
+		}
+	}
+
+	template<class ForwardIterator, class Compare>
+	ForwardIterator max_element(ForwardIterator first, ForwardIterator last, Compare comp){
+		return max_element_aux(first, last, comp, is_simd_order<ForwardIterator, Compare>());
+	}
+
+	template<class ForwardIterator>
+	ForwardIterator max_element(ForwardIterator first, ForwardIterator last){
+		return MySTL::max_element(first, last, less<typename iterator_traits<ForwardIterator>::value_type>());
+	}
+
+	//********** [accumulate] ******************************
+	//********* [Algorithm Complexity: O(N)] ****************
+	//left to right, only integer sums (which come out the same in any order) go to SIMD
+	namespace {
+		template<class InputIterator, class T>
+		T accumulate_aux(InputIterator first, InputIterator last, T init, std::false_type){
+			for (; first != last; ++first)
+				init = init + *first;
+			return init;
+		}
+
+		template<class Pointer, class T>
+		T accumulate_aux(Pointer first, Pointer last, T init, std::true_type){
+			return init + Detail::simd_sum(first, last - first);
+		}
+	}
+
+	template<class InputIterator, class T, class BinaryOperation>
+	T accumulate(InputIterator first, InputIterator last, T init, BinaryOperation op){
+		for (; first != last; ++first)
+			init = op(init, *first);
+		return init;
+	}
+
+	template<class InputIterator, class T>
+	T accumulate(InputIterator first, InputIterator last, T init){
+		return accumulate_aux(first, last, init, is_simd_sum<InputIterator, T, true>());
+	}
+
+	//********** [reduce] ******************************
+	//********* [Algorithm Complexity: O(N)] ****************
+	//like accumulate but the items may be added in any order, so float sums go to SIMD too
+	//and may round differently from accumulate
+	namespace {
+		template<class InputIterator, class T>
+		T reduce_aux(InputIterator first, InputIterator last, T init, std::false_type){
+			return accumulate_aux(first, last, init, std::false_type());
+		}
+
+		template<class Pointer, class T>
+		T reduce_aux(Pointer first, Pointer last, T init, std::true_type){
+			return init + Detail::simd_sum(first, last - first);
+		}
+	}
+
+	template<class InputIterator, class T, class BinaryOperation>
+	T reduce(InputIterator first, InputIterator last, T init, BinaryOperation op){
+		return MySTL::accumulate(first, last, init, op);
+	}
+
+	template<class InputIterator, class T>
+	T reduce(InputIterator first, InputIterator last, T init){
+		return reduce_aux(first, last, init, is_simd_sum<InputIterator, T, false>());
+	}
+
+	template<class InputIterator>
+	typename iterator_traits<InputIterator>::value_type reduce(InputIterator first, InputIterator last){
+		return MySTL::reduce(first, last, typename iterator_traits<InputIterator>::value_type());
+	}
+
+	//********** [transform] ******************************
+	//********* [Algorithm Complexity: O(N)] ****************
+	//a plain loop, over pointers the compiler vectorizes it for simple op
+	template<class InputIterator, class OutputIterator, class UnaryOperation>
+	OutputIterator transform(InputIterator first, InputIterator last, OutputIterator result, UnaryOperation op){
+		for (; first != last; ++first, ++result)
+			*result = op(*first);
+		return result;
+	}
+
+	template<class InputIterator1, class InputIterator2, class OutputIterator, class BinaryOperation>
+	OutputIterator transform(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2,
+		OutputIterator result, BinaryOperation op){
+		for (; first1 != last1; ++first1, ++first2, ++result)
+			*result = op(*first1, *first2);
+		return result;
+	}
+
 	//********** [advance] ******************************
 	//********* [Algorithm Complexity: O(N)] ****************
 	namespace {
@@ -519,71 +909,806 @@ namespace MySTL{
 
 	template <class InputIterator, class Distance>
 	void advance(InputIterator& it, Distance n){
-		typedef iterator_traits<InputIterator>::iterator_category iterator_category;
+		typedef typename iterator_traits<InputIterator>::iterator_category iterator_category;
 		_advance(it, n, iterator_category());
 	}
 
+	//********** [distance] ******************************
+	//********* [Algorithm Complexity: O(N)] ****************
+	template<class InputIterator>
+	typename iterator_traits<InputIterator>::difference_type
+		_distance(InputIterator first, InputIterator last, input_iterator_tag){
+		typename iterator_traits<InputIterator>::difference_type dist = 0;
+		while (first++ != last){
+			++dist;
+		}
+		return dist;
+	}
+
+	template<class RandomIterator>
+	typename iterator_traits<RandomIterator>::difference_type
+		_distance(RandomIterator first, RandomIterator last, random_access_iterator_tag){
+		auto dist = last - first;
+		return dist;
+	}
+
+	template<class Iterator>
+	typename iterator_traits<Iterator>::difference_type
+		distance(Iterator first, Iterator last){
+		typedef typename iterator_traits<Iterator>::iterator_category iterator_category;
+		return _distance(first, last, iterator_category());
+	}
+
+	//********** [lower_bound] ******************************
+	//********* [Algorithm Complexity: O(logN)] ****************
+	namespace {
+		//random access ranges are halved without a branch: the compare only picks which
+		//half to keep, which compiles to a conditional move, so a search costs no
+		//mispredicts, and there is always one compare per halving
+		template<class RandomIterator, class T, class Compare>
+		RandomIterator branchless_lower_bound(RandomIterator first, RandomIterator last, const T& val, Compare comp){
+			auto len = last - first;
+			if (len == 0)
+				return first;
+			while (len > 1){
+				auto half = len / 2;
+				//both items the next step may look at, so the miss overlaps this compare
+				MySTL::prefetch(&first[(len - half) / 2]);
+				MySTL::prefetch(&first[half + (len - half) / 2]);
+				first += comp(first[half], val) ? half : 0;
+				len -= half;
+			}
+			return first + (comp(*first, val) ? 1 : 0);
+		}
+
+		template<class RandomIterator, class T, class Compare>
+		RandomIterator branchless_upper_bound(RandomIterator first, RandomIterator last, const T& val, Compare comp){
+			auto len = last - first;
+			if (len == 0)
+				return first;
+			while (len > 1){
+				auto half = len / 2;
+				first += comp(val, first[half]) ? 0 : half;
+				len -= half;
+			}
+			return first + (comp(val, *first) ? 0 : 1);
+		}
+
+		template<class ForwardIterator, class T, class Compare>
+		ForwardIterator lower_bound_aux(ForwardIterator first, ForwardIterator last, const T& val, Compare comp, forward_iterator_tag){
+			auto len = MySTL::distance(first, last);
+			while (len > 0){
+				auto half = len / 2;
+				auto middle = first;
+				MySTL::advance(middle, half);
+				if (comp(*middle, val)){
+					first = ++middle;
+					len -= half + 1;
+				}
+				else{
+					len = half;
+				}
+			}
+			return first;
+		}
+
+		template<class RandomIterator, class T, class Compare>
+		RandomIterator lower_bound_aux(RandomIterator first, RandomIterator last, const T& val, Compare comp, random_access_iterator_tag){
+			return branchless_lower_bound(first, last, val, comp);
+		}
+
+		template<class ForwardIterator, class T, class Compare>
+		ForwardIterator upper_bound_aux(ForwardIterator first, ForwardIterator last, const T& val, Compare comp, forward_iterator_tag){
+			auto len = MySTL::distance(first, last);
+			while (len > 0){
+				auto half = len / 2;
+				auto middle = first;
+				MySTL::advance(middle, half);
+				if (!comp(val, *middle)){
+					first = ++middle;
+					len -= half + 1;
+				}
+				else{
+					len = half;
+				}
+			}
+			return first;
+		}
+
+		template<class RandomIterator, class T, class Compare>
+		RandomIterator upper_bound_aux(RandomIterator first, RandomIterator last, const T& val, Compare comp, random_access_iterator_tag){
+			return branchless_upper_bound(first, last, val, comp);
+		}
+	}
+
+	template<class ForwardIterator, class T, class Compare>
+	ForwardIterator lower_bound(ForwardIterator first, ForwardIterator last, const T& val, Compare comp){
+		typedef typename iterator_traits<ForwardIterator>::iterator_category iterator_category;
+		return lower_bound_aux(first, last, val, comp, iterator_category());
+	}
+
+	template<class ForwardIterator, class T>
+	ForwardIterator lower_bound(ForwardIterator first, ForwardIterator last, const T& val){
+		return MySTL::lower_bound(first, last, val, less<typename iterator_traits<ForwardIterator>::value_type>());
+	}
+
+	//********** [upper_bound] ******************************
+	//********* [Algorithm Complexity: O(logN)] ****************
+	template<class ForwardIterator, class T, class Compare>
+	ForwardIterator upper_bound(ForwardIterator first, ForwardIterator last, const T& val, Compare comp){
+		typedef typename iterator_traits<ForwardIterator>::iterator_category iterator_category;
+		return upper_bound_aux(first, last, val, comp, iterator_category());
+	}
+
+	template<class ForwardIterator, class T>
+	ForwardIterator upper_bound(ForwardIterator first, ForwardIterator last, const T& val){
+		return MySTL::upper_bound(first, last, val, less<typename iterator_traits<ForwardIterator>::value_type>());
+	}
+
+	//********** [equal_range] ******************************
+	//********* [Algorithm Complexity: O(logN)] ****************
+	template<class ForwardIterator, class T, class Compare>
+	pair<ForwardIterator, ForwardIterator> equal_range(ForwardIterator first, ForwardIterator last, const T& val, Compare comp){
+		ForwardIterator lower = MySTL::lower_bound(first, last, val, comp);
+		return MySTL::make_pair(lower, MySTL::upper_bound(lower, last, val, comp));
+	}
+
+	template<class ForwardIterator, class T>
+	pair<ForwardIterator, ForwardIterator> equal_range(ForwardIterator first, ForwardIterator last, const T& val){
+		return MySTL::equal_range(first, last, val, less<typename iterator_traits<ForwardIterator>::value_type>());
+	}
+
+	//********** [binary_search] ******************************
+	//********* [Algorithm Complexity: O(logN)] ****************
+	template<class ForwardIterator, class T, class Compare>
+	bool binary_search(ForwardIterator first, ForwardIterator last, const T& val, Compare comp){
+		first = MySTL::lower_bound(first, last, val, comp);
+		return first != last && !comp(val, *first);
+	}
+
+	template<class ForwardIterator, class T>
+	bool binary_search(ForwardIterator first, ForwardIterator last, const T& val){
+		return MySTL::binary_search(first, last, val, less<typename iterator_traits<ForwardIterator>::value_type>());
+	}
+
 	//********** [sort] ******************************
 	//********* [Algorithm Complexity: O(NlogN)] ****************
+	//pattern-defeating quicksort (pdqsort):
+	//1. the pivot is the median of 3, or the ninther on long ranges
+	//2. with a cheap comparator the partition is done in blocks without branches
+	//3. a range whose pivot equals the item before it holds a run of equal keys, the keys
+	//   equal to the pivot are put on the left and never looked at again
+	//4. a partition that swapped nothing is tried with a bounded insertion sort, so sorted
+	//   and reversed runs are linear
+	//5. unbalanced partitions shuffle a few items, too many of them fall back to heapsort
 	namespace {
+		const int SORT_THRESHOLD = 24;//ranges shorter than this are insertion sorted
+		const int NINTHER_THRESHOLD = 128;
+		const int PARTIAL_INSERTION_LIMIT = 8;//items moved before a partial insertion sort gives up
+		const int PARTITION_BLOCK = 64;//must fit the unsigned char offsets
+
+		//arithmetic items with the default less are cheap enough for the branchless partition
+		template<class T, class BinaryPredicate>
+		struct branchless_partition{ static const bool value = false; };
+		template<class T>
+		struct branchless_partition<T, MySTL::less<T>>{ static const bool value = std::is_arithmetic<T>::value; };
+
+		template<class RandomIterator, class BinaryPredicate>
+		void insertion_sort(RandomIterator first, RandomIterator last, BinaryPredicate pred){
+			if (first == last)
+				return;
+			for (auto i = first + 1; i != last; ++i){
+				auto j = i;
+				if (pred(*j, *(j - 1))){
+					auto val = std::move(*j);
+					do{
+						*j = std::move(*(j - 1));
+						--j;
+					} while (j != first && pred(val, *(j - 1)));
+					*j = std::move(val);
+				}
+			}
+		}
+
+		//*(first - 1) is not greater than any item of [first, last)
 		template<class RandomIterator, class BinaryPredicate>
-		typename iterator_traits<RandomIterator>::value_type
-			mid3(RandomIterator first, RandomIterator last, BinaryPredicate pred){//[first, last]
-			auto mid = first + (last + 1 - first) / 2;
-			if (pred(*mid, *first)){
-				swap(*mid, *first);
+		void unguarded_insertion_sort(RandomIterator first, RandomIterator last, BinaryPredicate pred){
+			if (first == last)
+				return;
+			for (auto i = first + 1; i != last; ++i){
+				auto j = i;
+				if (pred(*j, *(j - 1))){
+					auto val = std::move(*j);
+					do{
+						*j = std::move(*(j - 1));
+						--j;
+					} while (pred(val, *(j - 1)));
+					*j = std::move(val);
+				}
 			}
-			if (pred(*last, *mid)){
-				swap(*last, *mid);
+		}
+
+		//insertion sort that gives up and returns false once it has moved too many items
+		template<class RandomIterator, class BinaryPredicate>
+		bool partial_insertion_sort(RandomIterator first, RandomIterator last, BinaryPredicate pred){
+			if (first == last)
+				return true;
+			int moved = 0;
+			for (auto i = first + 1; i != last; ++i){
+				auto j = i;
+				if (pred(*j, *(j - 1))){
+					auto val = std::move(*j);
+					do{
+						*j = std::move(*(j - 1));
+						--j;
+					} while (j != first && pred(val, *(j - 1)));
+					*j = std::move(val);
+					moved += static_cast<int>(i - j);
+				}
+				if (moved > PARTIAL_INSERTION_LIMIT)
+					return false;
 			}
-			if (pred(*last, *first)){
-				swap(*last, *first);
+			return true;
+		}
+
+		//order *a <= *b <= *c
+		template<class RandomIterator, class BinaryPredicate>
+		void sort3(RandomIterator a, RandomIterator b, RandomIterator c, BinaryPredicate pred){
+			if (pred(*b, *a))
+				MySTL::swap(*a, *b);
+			if (pred(*c, *b)){
+				MySTL::swap(*b, *c);
+				if (pred(*b, *a))
+					MySTL::swap(*a, *b);
 			}
-			auto ret = *mid;
-			swap(*mid, *(last - 1));//mid itemλΪڱ
-			return ret;
 		}
 
+		//move the pivot to *first, an item not less than it and one not greater than it
+		//are left in the range, they stop the unguarded scans of the partitions
 		template<class RandomIterator, class BinaryPredicate>
-		void bubble_sort(RandomIterator first, RandomIterator last, BinaryPredicate pred){
-			auto len = last - first;
-			for (auto i = len; i != 0; --i){
-				bool swaped = false;
-				for (auto p = first; p != (first + i - 1); ++p){
-					if (pred(*(p + 1), *p)){
-						swap(*(p + 1), *p);
-						swaped = true;
+		void choose_pivot(RandomIterator first, RandomIterator last, BinaryPredicate pred){
+			auto half = (last - first) / 2;
+			if (last - first > NINTHER_THRESHOLD){
+				sort3(first, first + half, last - 1, pred);
+				sort3(first + 1, first + (half - 1), last - 2, pred);
+				sort3(first + 2, first + (half + 1), last - 3, pred);
+				sort3(first + (half - 1), first + half, first + (half + 1), pred);
+				MySTL::swap(*first, *(first + half));
+			}
+			else{
+				sort3(first + half, first, last - 1, pred);
+			}
+		}
+
+		//move the items *(first + offsets_l[i]) and *(last - offsets_r[i]) across
+		template<class RandomIterator>
+		void swap_offsets(RandomIterator first, RandomIterator last,
+			const unsigned char *offsets_l, const unsigned char *offsets_r, int num, bool use_swaps){
+			if (use_swaps){//keeps descending input linear
+				for (int i = 0; i < num; ++i)
+					MySTL::swap(*(first + offsets_l[i]), *(last - offsets_r[i]));
+			}
+			else if (num > 0){//a cycle of moves instead of swaps
+				auto l = first + offsets_l[0], r = last - offsets_r[0];
+				auto tmp = std::move(*l);
+				*l = std::move(*r);
+				for (int i = 1; i < num; ++i){
+					l = first + offsets_l[i];
+					*r = std::move(*l);
+					r = last - offsets_r[i];
+					*l = std::move(*r);
+				}
+				*r = std::move(tmp);
+			}
+		}
+
+		//partition [first + 1, last) around *first into items less than the pivot and items
+		//not less than it, return the final place of the pivot and whether nothing had to move
+		template<bool Branchless, class RandomIterator, class BinaryPredicate>
+		MySTL::pair<RandomIterator, bool> partition_right(RandomIterator first, RandomIterator last, BinaryPredicate pred){
+			auto pivot = std::move(*first);
+			auto l = first, r = last;
+			while (pred(*++l, pivot));
+			if (l - 1 == first)
+				while (l < r && !pred(*--r, pivot));
+			else
+				while (!pred(*--r, pivot));
+			bool already_partitioned = l >= r;
+			if (!already_partitioned){
+				MySTL::swap(*l, *r);
+				++l;
+				if (Branchless){
+					//collect the offsets of misplaced items block by block, then swap them
+					unsigned char offsets_l[PARTITION_BLOCK], offsets_r[PARTITION_BLOCK];
+					auto base_l = l, base_r = r;
+					int num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+					while (l < r){
+						auto unknown = r - l;
+						auto left_split = num_l == 0 ? (num_r == 0 ? unknown / 2 : unknown) : 0;
+						auto right_split = num_r == 0 ? unknown - left_split : 0;
+						if (left_split > PARTITION_BLOCK) left_split = PARTITION_BLOCK;
+						if (right_split > PARTITION_BLOCK) right_split = PARTITION_BLOCK;
+						for (int i = 0; i < left_split; ++l){
+							offsets_l[num_l] = static_cast<unsigned char>(i++);
+							num_l += !pred(*l, pivot);
+						}
+						for (int i = 0; i < right_split;){
+							offsets_r[num_r] = static_cast<unsigned char>(++i);
+							num_r += pred(*--r, pivot);
+						}
+						int num = MySTL::min(num_l, num_r);
+						swap_offsets(base_l, base_r, offsets_l + start_l, offsets_r + start_r, num, num_l == num_r);
+						num_l -= num; num_r -= num;
+						start_l += num; start_r += num;
+						if (num_l == 0){
+							start_l = 0;
+							base_l = l;
+						}
+						if (num_r == 0){
+							start_r = 0;
+							base_r = r;
+						}
+					}
+					//one side may still hold misplaced items, move them to the boundary
+					while (num_l != 0){
+						--num_l;
+						MySTL::swap(*(base_l + offsets_l[start_l + num_l]), *--r);
+					}
+					if (l > r)
+						l = r;
+					while (num_r != 0){
+						--num_r;
+						MySTL::swap(*(base_r - offsets_r[start_r + num_r]), *l);
+						++l;
 					}
 				}
-				if (!swaped)
-					break;
+				else{
+					while (true){
+						while (pred(*l, pivot)) ++l;
+						while (!pred(*--r, pivot));
+						if (!(l < r))
+							break;
+						MySTL::swap(*l, *r);
+						++l;
+					}
+				}
+			}
+			auto pivot_pos = l - 1;
+			*first = std::move(*pivot_pos);
+			*pivot_pos = std::move(pivot);
+			return MySTL::pair<RandomIterator, bool>(pivot_pos, already_partitioned);
+		}
+
+		//partition [first + 1, last) around *first into items not greater than the pivot and
+		//items greater than it, used when no item of the range is less than the pivot
+		template<class RandomIterator, class BinaryPredicate>
+		RandomIterator partition_left(RandomIterator first, RandomIterator last, BinaryPredicate pred){
+			auto pivot = std::move(*first);
+			auto l = first, r = last;
+			while (pred(pivot, *--r));
+			if (r + 1 == last)
+				while (l < r && !pred(pivot, *++l));
+			else
+				while (!pred(pivot, *++l));
+			while (l < r){
+				MySTL::swap(*l, *r);
+				while (pred(pivot, *--r));
+				while (!pred(pivot, *++l));
+			}
+			*first = std::move(*r);
+			*r = std::move(pivot);
+			return r;
+		}
+
+		template<bool Branchless, class RandomIterator, class BinaryPredicate>
+		void pdqsort_loop(RandomIterator first, RandomIterator last, int bad_allowed, bool leftmost, BinaryPredicate pred){
+			while (true){
+				auto len = last - first;
+				if (len < SORT_THRESHOLD){
+					if (leftmost)
+						insertion_sort(first, last, pred);
+					else
+						unguarded_insertion_sort(first, last, pred);
+					return;
+				}
+				choose_pivot(first, last, pred);
+				//the item before the range is not greater than any item of it, if it equals
+				//the pivot the keys equal to the pivot are already in place
+				if (!leftmost && !pred(*(first - 1), *first)){
+					first = partition_left(first, last, pred) + 1;
+					continue;
+				}
+				auto part = partition_right<Branchless>(first, last, pred);
+				auto pivot_pos = part.first;
+				auto l_len = pivot_pos - first, r_len = last - (pivot_pos + 1);
+				if (l_len < len / 8 || r_len < len / 8){//highly unbalanced
+					if (--bad_allowed == 0){
+						MySTL::make_heap(first, last, pred);
+						MySTL::sort_heap(first, last, pred);
+						return;
+					}
+					//shuffle a few items to break the pattern
+					if (l_len >= SORT_THRESHOLD){
+						MySTL::swap(*first, *(first + l_len / 4));
+						MySTL::swap(*(pivot_pos - 1), *(pivot_pos - l_len / 4));
+						if (l_len > NINTHER_THRESHOLD){
+							MySTL::swap(*(first + 1), *(first + (l_len / 4 + 1)));
+							MySTL::swap(*(first + 2), *(first + (l_len / 4 + 2)));
+							MySTL::swap(*(pivot_pos - 2), *(pivot_pos - (l_len / 4 + 1)));
+							MySTL::swap(*(pivot_pos - 3), *(pivot_pos - (l_len / 4 + 2)));
+						}
+					}
+					if (r_len >= SORT_THRESHOLD){
+						MySTL::swap(*(pivot_pos + 1), *(pivot_pos + (1 + r_len / 4)));
+						MySTL::swap(*(last - 1), *(last - r_len / 4));
+						if (r_len > NINTHER_THRESHOLD){
+							MySTL::swap(*(pivot_pos + 2), *(pivot_pos + (2 + r_len / 4)));
+							MySTL::swap(*(pivot_pos + 3), *(pivot_pos + (3 + r_len / 4)));
+							MySTL::swap(*(last - 2), *(last - (1 + r_len / 4)));
+							MySTL::swap(*(last - 3), *(last - (2 + r_len / 4)));
+						}
+					}
+				}
+				else if (part.second && partial_insertion_sort(first, pivot_pos, pred)
+					&& partial_insertion_sort(pivot_pos + 1, last, pred)){
+					return;//the range was (nearly) sorted already
+				}
+				pdqsort_loop<Branchless>(first, pivot_pos, bad_allowed, leftmost, pred);
+				first = pivot_pos + 1;
+				leftmost = false;
 			}
 		}
 	}
 
+	template<class RandomIterator, class BinaryPredicate>
+	void sort(RandomIterator first, RandomIterator last, BinaryPredicate pred){
+		if (last - first < 2)
+			return;
+		int bad_allowed = 0;//lgN bad partitions before heapsort
+		for (auto n = last - first; n > 1; n >>= 1)
+			++bad_allowed;
+		typedef typename iterator_traits<RandomIterator>::value_type value_type;
+		pdqsort_loop<branchless_partition<value_type, BinaryPredicate>::value>(first, last, bad_allowed, true, pred);
+	}
+
 	template<class RandomIterator>
 	void sort(RandomIterator first, RandomIterator last){
-		return sort(first, last, less<typename iterator_traits<RandomIterator>::value_type>());
+		return MySTL::sort(first, last, less<typename iterator_traits<RandomIterator>::value_type>());
 	}
 
-	template<class RandomIterator, class BinaryPredicate>
-	void sort(RandomIterator first, RandomIterator last, BinaryPredicate pred){
-		if (first >= last || first + 1 == last)
+	//********** [merge] ******************************
+	//********* [Algorithm Complexity: O(N)] ****************
+	//stable, of equal items those of the first range come first
+	template<class InputIterator1, class InputIterator2, class OutputIterator, class Compare>
+	OutputIterator merge(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, InputIterator2 last2,
+		OutputIterator result, Compare comp){
+		for (; first1 != last1 && first2 != last2; ++result){
+			if (comp(*first2, *first1)){
+				*result = *first2;
+				++first2;
+			}
+			else{
+				*result = *first1;
+				++first1;
+			}
+		}
+		for (; first1 != last1; ++first1, ++result)
+			*result = *first1;
+		for (; first2 != last2; ++first2, ++result)
+			*result = *first2;
+		return result;
+	}
+
+	template<class InputIterator1, class InputIterator2, class OutputIterator>
+	OutputIterator merge(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, InputIterator2 last2,
+		OutputIterator result){
+		return MySTL::merge(first1, last1, first2, last2, result,
+			less<typename iterator_traits<InputIterator1>::value_type>());
+	}
+
+	//********** [stable_sort] ******************************
+	//********* [Algorithm Complexity: O(NlogN), O(N) on sorted runs] ****************
+	//stable_sort is a natural merge sort in the manner of timsort: ascending and strictly
+	//descending runs are found and kept, short runs are extended by insertion sort and
+	//the runs are merged while their lengths keep the timsort invariants
+	//a merge moves its shorter run to a scratch buffer, once the buffer is too short the
+	//runs are split and rotated instead, so any buffer size works, only slower
+	namespace {
+		const int MIN_MERGE = 32;//ranges shorter than this are insertion sorted
+		const int MAX_MERGE_PENDING = 85;//enough runs for 2^64 items
+
+		//uninitialized scratch memory, a merge move-constructs the items it parks there and
+		//destroys them once they are moved back
+		template<class T>
+		class temporary_buffer{
+		private:
+			T *data_;
+			size_t size_;
+		public:
+			explicit temporary_buffer(size_t n) :data_(n != 0 ? allocator<T>::allocate(n) : 0), size_(n){}
+			temporary_buffer(const temporary_buffer&) = delete;
+			temporary_buffer& operator = (const temporary_buffer&) = delete;
+			~temporary_buffer(){
+				if (data_ != 0)
+					allocator<T>::deallocate(data_, size_);
+			}
+			T *data(){ return data_; }
+			size_t size()const{ return size_; }
+		};
+
+		//how a merge uses its scratch space: Raw for a temporary_buffer, otherwise the
+		//caller's buffer of live items, which are only assigned to
+		template<bool Raw>
+		struct scratch_ops{
+			template<class T, class U>
+			static void park(T *p, U&& val){ ::new (static_cast<void *>(p)) T(std::move(val)); }
+			template<class T>
+			static void release(T *first, T *last){
+				for (; first != last; ++first)
+					first->~T();
+			}
+		};
+		template<>
+		struct scratch_ops<false>{
+			template<class T, class U>
+			static void park(T *p, U&& val){ *p = std::move(val); }
+			template<class T>
+			static void release(T *, T *){}
+		};
+
+		template<class RandomIterator>
+		void reverse_range(RandomIterator first, RandomIterator last){
+			for (; first < last; ++first)
+				MySTL::swap(*first, *--last);
+		}
+
+		//rotate [first, last) so that middle comes first, return the new place of first
+		template<class RandomIterator>
+		RandomIterator rotate_range(RandomIterator first, RandomIterator middle, RandomIterator last){
+			reverse_range(first, middle);
+			reverse_range(middle, last);
+			reverse_range(first, last);
+			return first + (last - middle);
+		}
+
+		//merge the sorted runs [first, middle) and [middle, last)
+		template<bool Raw, class RandomIterator, class T, class Compare>
+		void merge_adaptive(RandomIterator first, RandomIterator middle, RandomIterator last,
+			T *buffer, ptrdiff_t buffer_size, Compare comp){
+			if (first == middle || middle == last)
+				return;
+			//the head of the left run and the tail of the right run are in place already
+			first = branchless_upper_bound(first, middle, *middle, comp);
+			if (first == middle)
+				return;
+			last = branchless_lower_bound(middle, last, *(middle - 1), comp);
+			const ptrdiff_t len1 = middle - first, len2 = last - middle;
+			if (len1 + len2 == 2){//*first is greater than *middle
+				MySTL::swap(*first, *middle);
+			}
+			else if (len1 <= len2 && len1 <= buffer_size){//merge forward from the buffer
+				auto buffer_end = buffer;
+				for (auto it = first; it != middle; ++it, ++buffer_end)
+					scratch_ops<Raw>::park(buffer_end, *it);
+				auto out = first;
+				for (auto b = buffer; b != buffer_end; ++out){
+					if (middle != last && comp(*middle, *b))
+						*out = std::move(*middle++);
+					else
+						*out = std::move(*b++);
+				}
+				scratch_ops<Raw>::release(buffer, buffer_end);
+			}
+			else if (len2 <= buffer_size){//merge backward from the buffer
+				auto buffer_end = buffer;
+				for (auto it = middle; it != last; ++it, ++buffer_end)
+					scratch_ops<Raw>::park(buffer_end, *it);
+				const auto parked_end = buffer_end;
+				auto out = last;
+				while (buffer_end != buffer){
+					if (middle != first && comp(*(buffer_end - 1), *(middle - 1)))
+						*--out = std::move(*--middle);
+					else
+						*--out = std::move(*--buffer_end);
+				}
+				scratch_ops<Raw>::release(buffer, parked_end);
+			}
+			else{//split the longer run, rotate the middle parts and merge both halves
+				RandomIterator cut1, cut2;
+				if (len1 > len2){
+					cut1 = first + len1 / 2;
+					cut2 = branchless_lower_bound(middle, last, *cut1, comp);
+				}
+				else{
+					cut2 = middle + len2 / 2;
+					cut1 = branchless_upper_bound(first, middle, *cut2, comp);
+				}
+				auto new_middle = rotate_range(cut1, middle, cut2);
+				merge_adaptive<Raw>(first, cut1, new_middle, buffer, buffer_size, comp);
+				merge_adaptive<Raw>(new_middle, cut2, last, buffer, buffer_size, comp);
+			}
+		}
+
+		//the end of the run starting at first, a strictly descending run is reversed
+		template<class RandomIterator, class Compare>
+		RandomIterator count_run(RandomIterator first, RandomIterator last, Compare comp){
+			auto run = first + 1;
+			if (run == last)
+				return last;
+			if (comp(*run, *first)){
+				while (++run != last && comp(*run, *(run - 1)));
+				reverse_range(first, run);
+			}
+			else{
+				while (++run != last && !comp(*run, *(run - 1)));
+			}
+			return run;
+		}
+
+		//a run length between MIN_MERGE / 2 and MIN_MERGE that splits n into about a power of 2 runs
+		inline ptrdiff_t min_run_length(ptrdiff_t n){
+			ptrdiff_t r = 0;
+			while (n >= MIN_MERGE){
+				r |= n & 1;
+				n >>= 1;
+			}
+			return n + r;
+		}
+
+		template<bool Raw, class RandomIterator, class T, class Compare>
+		void stable_sort_aux(RandomIterator first, RandomIterator last, T *buffer, ptrdiff_t buffer_size, Compare comp){
+			const ptrdiff_t n = last - first;
+			if (n < MIN_MERGE){
+				insertion_sort(first, last, comp);
+				return;
+			}
+			const ptrdiff_t min_run = min_run_length(n);
+			ptrdiff_t run_base[MAX_MERGE_PENDING], run_len[MAX_MERGE_PENDING];
+			int runs = 0;
+			auto merge_at = [&](int i){
+				auto base = first + run_base[i];
+				merge_adaptive<Raw>(base, base + run_len[i], base + (run_len[i] + run_len[i + 1]), buffer, buffer_size, comp);
+				run_len[i] += run_len[i + 1];
+				if (i + 2 < runs){
+					run_base[i + 1] = run_base[i + 2];
+					run_len[i + 1] = run_len[i + 2];
+				}
+				--runs;
+			};
+			for (auto cur = first; cur != last;){
+				auto run_end = count_run(cur, last, comp);
+				if (run_end - cur < min_run){
+					run_end = last - cur < min_run ? last : cur + min_run;
+					insertion_sort(cur, run_end, comp);
+				}
+				run_base[runs] = cur - first;
+				run_len[runs] = run_end - cur;
+				++runs;
+				cur = run_end;
+				//keep len[i - 2] > len[i - 1] + len[i] and len[i - 1] > len[i] on the stack
+				while (runs > 1){
+					int i = runs - 2;
+					if ((i > 0 && run_len[i - 1] <= run_len[i] + run_len[i + 1]) ||
+						(i > 1 && run_len[i - 2] <= run_len[i - 1] + run_len[i])){
+						if (run_len[i - 1] < run_len[i + 1])
+							--i;
+					}
+					else if (run_len[i] > run_len[i + 1]){
+						break;
+					}
+					merge_at(i);
+				}
+			}
+			while (runs > 1){
+				int i = runs - 2;
+				if (i > 0 && run_len[i - 1] < run_len[i + 1])
+					--i;
+				merge_at(i);
+			}
+		}
+	}
+
+	//********** [inplace_merge] ******************************
+	//********* [Algorithm Complexity: O(N) with memory for the shorter run, O(NlogN) without] ****************
+	template<class RandomIterator, class Compare>
+	void inplace_merge(RandomIterator first, RandomIterator middle, RandomIterator last, Compare comp){
+		typedef typename iterator_traits<RandomIterator>::value_type value_type;
+		const auto len1 = middle - first, len2 = last - middle;
+		temporary_buffer<value_type> buffer(len1 < len2 ? len1 : len2);
+		merge_adaptive<true>(first, middle, last, buffer.data(), static_cast<ptrdiff_t>(buffer.size()), comp);
+	}
+
+	template<class RandomIterator>
+	void inplace_merge(RandomIterator first, RandomIterator middle, RandomIterator last){
+		MySTL::inplace_merge(first, middle, last, less<typename iterator_traits<RandomIterator>::value_type>());
+	}
+
+	//buffer holds buffer_size items to use as scratch space, (last - first) / 2 items
+	//are enough for every merge to be linear
+	template<class RandomIterator, class Compare>
+	void stable_sort(RandomIterator first, RandomIterator last, Compare comp,
+		typename iterator_traits<RandomIterator>::value_type *buffer, size_t buffer_size){
+		stable_sort_aux<false>(first, last, buffer, static_cast<ptrdiff_t>(buffer_size), comp);
+	}
+
+	template<class RandomIterator, class Compare>
+	void stable_sort(RandomIterator first, RandomIterator last, Compare comp){
+		typedef typename iterator_traits<RandomIterator>::value_type value_type;
+		const auto len = last - first;
+		temporary_buffer<value_type> buffer(len < MIN_MERGE ? 0 : len / 2);
+		stable_sort_aux<true>(first, last, buffer.data(), static_cast<ptrdiff_t>(buffer.size()), comp);
+	}
+
+	template<class RandomIterator>
+	void stable_sort(RandomIterator first, RandomIterator last){
+		MySTL::stable_sort(first, last, less<typename iterator_traits<RandomIterator>::value_type>());
+	}
+
+	//********** [partial_sort] ******************************
+	//********* [Algorithm Complexity: O(NlogK)] ****************
+	//sort the smallest middle - first items into [first, middle), the rest is left in any order
+	template<class RandomIterator, class Compare>
+	void partial_sort(RandomIterator first, RandomIterator middle, RandomIterator last, Compare comp){
+		if (first == middle)
+			return;
+		typedef typename iterator_traits<RandomIterator>::value_type value_type;
+		MySTL::make_heap(first, middle, comp);
+		for (auto it = middle; it != last; ++it){
+			if (comp(*it, *first)){//replace the greatest of the k smallest so far
+				value_type val = std::move(*it);
+				*it = std::move(*first);
+				heap_sift_down_floyd<2>(first, static_cast<decltype(middle - first)>(0), middle - first, std::move(val), comp);
+			}
+		}
+		MySTL::sort_heap(first, middle, comp);
+	}
+
+	template<class RandomIterator>
+	void partial_sort(RandomIterator first, RandomIterator middle, RandomIterator last){
+		MySTL::partial_sort(first, middle, last, less<typename iterator_traits<RandomIterator>::value_type>());
+	}
+
+	//********** [nth_element] ******************************
+	//********* [Algorithm Complexity: O(N)] ****************
+	//put the item that sort would put at nth there, no item before it is greater and no
+	//item after it is less; quickselect with the partitions of sort
+	template<class RandomIterator, class Compare>
+	void nth_element(RandomIterator first, RandomIterator nth, RandomIterator last, Compare comp){
+		typedef typename iterator_traits<RandomIterator>::value_type value_type;
+		if (nth == last)
 			return;
-		if (last - first <= 20)//䳤Сڵ20Ĳð
-			return bubble_sort(first, last, pred);
-		auto mid = mid3(first, last - 1, pred);
-		auto p1 = first, p2 = last - 2;
-		while (p1 < p2){
-			while (pred(*p1, mid) && (p1 < p2)) ++p1;
-			while (!pred(*p2, mid) && (p1 < p2)) --p2;
-			if (p1 < p2){
-				swap(*p1, *p2);
+		const auto begin = first;
+		int bad_allowed = 0;
+		for (auto n = last - first; n > 1; n >>= 1)
+			++bad_allowed;
+		while (last - first >= SORT_THRESHOLD){
+			choose_pivot(first, last, comp);
+			if (first != begin && !comp(*(first - 1), *first)){//keys equal to the pivot
+				auto pos = partition_left(first, last, comp);
+				if (nth <= pos)
+					return;
+				first = pos + 1;
+				continue;
 			}
+			auto len = last - first;
+			auto pivot_pos = partition_right<branchless_partition<value_type, Compare>::value>(first, last, comp).first;
+			if (pivot_pos == nth)
+				return;
+			if ((pivot_pos - first < len / 8 || last - pivot_pos - 1 < len / 8) && --bad_allowed == 0){
+				MySTL::sort(first, last, comp);
+				return;
+			}
+			if (nth < pivot_pos)
+				last = pivot_pos;
+			else
+				first = pivot_pos + 1;
 		}
-		swap(*p1, *(last - 2));//Ϊڱmid itemԭλ
-		sort(first, p1, pred);
-		sort(p1 + 1, last, pred);
+		insertion_sort(first, last, comp);
+	}
+
+	template<class RandomIterator>
+	void nth_element(RandomIterator first, RandomIterator nth, RandomIterator last){
+		MySTL::nth_element(first, nth, last, less<typename iterator_traits<RandomIterator>::value_type>());
 	}
 
 	//********** [generate] ******************************
@@ -605,32 +1730,6 @@ namespace MySTL{
 		}
 	}
 
-	//********** [distance] ******************************
-	//********* [Algorithm Complexity: O(N)] ****************
-	template<class InputIterator>
-	typename iterator_traits<InputIterator>::difference_type
-		_distance(InputIterator first, InputIterator last, input_iterator_tag){
-		typename iterator_traits<InputIterator>::difference_type dist = 0;
-		while (first++ != last){
-			++dist;
-		}
-		return dist;
-	}
-
-	template<class RandomIterator>
-	typename iterator_traits<RandomIterator>::difference_type
-		_distance(RandomIterator first, RandomIterator last, random_access_iterator_tag){
-		auto dist = last - first;
-		return dist;
-	}
-
-	template<class Iterator>
-	typename iterator_traits<Iterator>::difference_type
-		distance(Iterator first, Iterator last){
-		typedef typename iterator_traits<Iterator>::iterator_category iterator_category;
-		return _distance(first, last, iterator_category());
-	}
-
 	//********** [copy] ******************************
 	//********* [Algorithm Complexity: O(N)] ****************
 	template<class InputIterator, class OutputIterator>
@@ -653,7 +1752,7 @@ namespace MySTL{
 
 	template<class InputIterator, class OutputIterator, class T>
 	OutputIterator _copy(InputIterator first, InputIterator last, OutputIterator result, T*){
-		typedef typename TinySTL::_type_traits<T>::is_POD_type is_pod;
+		typedef typename MySTL::_type_traits<T>::is_POD_type is_pod;
 		return __copy(first, last, result, is_pod());
 	}
 
@@ -15,6 +15,7 @@ namespace MySTL{
 		enum EMaxBytes { MAXBYTES = 128 };// Сޣmalloc
 		enum ENFreeLists { NFREELISTS = (EMaxBytes::MAXBYTES / EAlign::ALIGN) };// free-listsĸ
 		enum ENObjs { NOBJS = 20 }; // ÿӵĽڵ
+		enum EMaxCached { MAXCACHED = 4 * ENObjs::NOBJS };// blocks a thread keeps per free-list before giving some back
 
 	private:
 		// free-listsĽڵ㹹
@@ -23,6 +24,9 @@ namespace MySTL{
 			char client[1];
 		};
 
+		// every thread allocates from and frees into free-lists of its own without any
+		// lock, free_list is the shared pool they are refilled from and flushed into
+		struct thread_cache;
 		static obj *free_list[ENFreeLists::NFREELISTS];
 	private:
 		static char *start_free;// ڴʼλ
@@ -42,6 +46,12 @@ namespace MySTL{
 		// һռ䣬nobjsСΪsize
 		// nobjs㣬nobjsܻή
 		static char *chunk_alloc(size_t size, size_t &objs);
+		static thread_cache& local_cache();
+		// give all but the first keep blocks of a thread's free-list back to the pool
+		static void trim(thread_cache& cache, size_t index, size_t keep);
+		// a block from, or back to, the shared free-lists, for a thread without a cache
+		static void *allocate_shared(size_t bytes);
+		static void deallocate_shared(void *ptr, size_t bytes);
 
 	public:
 		static void *allocate(size_t bytes);
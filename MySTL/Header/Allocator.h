@@ -5,6 +5,7 @@
 #include "Construct.h"
 
 #include <cassert>
+#include <cstddef>
 #include <new>
 
 namespace MySTL{
@@ -0,0 +1,251 @@
+#ifndef _BTREE_H_
+#define _BTREE_H_
+
+#include "Allocator.h"
+#include "Functional.h"
+#include "Iterator.h"
+#include "Utility.h"
+
+namespace MySTL{
+	namespace Detail{
+		// what an iterator shows of a value, a set value is read-only as a whole
+		template<class Value>
+		struct btree_const_access{
+			typedef const Value& reference;
+			typedef const Value *pointer;
+			static reference get(Value& val){ return val; }
+			static pointer address(Value& val){ return &val; }
+		};
+		// a map value is shown through a view with a read-only key and a mutable mapped
+		// value, the leaves keep plain pairs so that their slots can shift by assignment
+		template<class Key, class T>
+		struct btree_map_access{
+			struct reference{
+				const Key& first;
+				T& second;
+				explicit reference(MySTL::pair<Key, T>& val) :first(val.first), second(val.second){}
+			};
+			struct pointer{// it->second needs an object for -> to point to
+				reference ref_;
+				const reference *operator->()const{ return &ref_; }
+			};
+			static reference get(MySTL::pair<Key, T>& val){ return reference(val); }
+			static pointer address(MySTL::pair<Key, T>& val){ pointer p = { reference(val) }; return p; }
+		};
+
+		template<class Key, class Value, class KeyOfValue, class Compare, class Access = btree_const_access<Value>>
+		class btree;
+
+		// class of btree iterator, a leaf and a slot in it
+		// the leaves are linked so that ++ and -- never climb the tree
+		template<class Value, class Tree>
+		class btree_iter : public iterator<bidirectional_iterator_tag, Value>{
+		private:
+			template<class K_, class V_, class KOV_, class Cmp_, class Acc_>
+			friend class btree;
+		private:
+			typedef typename Tree::leaf_node leaf_node;
+			typedef typename Tree::access_type access_type;
+			typedef const Tree *cntrPtr;
+		private:
+			leaf_node *leaf_;
+			size_t slot_;
+			cntrPtr container_;
+		public:
+			btree_iter() :leaf_(0), slot_(0), container_(0){}
+			btree_iter(leaf_node *leaf, size_t slot, cntrPtr container)
+				:leaf_(leaf), slot_(slot), container_(container){}
+
+			typedef typename access_type::reference reference;
+			typedef typename access_type::pointer pointer;
+
+			reference operator*()const{ return access_type::get(leaf_->values_[slot_]); }
+			pointer operator->()const{ return access_type::address(leaf_->values_[slot_]); }
+			btree_iter& operator ++();
+			btree_iter operator ++(int);
+			btree_iter& operator --();
+			btree_iter operator --(int);
+			bool operator ==(const btree_iter& it)const{ return leaf_ == it.leaf_ && slot_ == it.slot_; }
+			bool operator !=(const btree_iter& it)const{ return !(*this == it); }
+		};
+
+		// class of in-memory B+ tree
+		// all values live in the leaves, the inner nodes only keep separator keys,
+		// and a node holds as many slots as fit in BTREE_NODE_BYTES so that a lookup
+		// touches a few cache lines per level instead of one node per comparison
+		template<class Key, class Value, class KeyOfValue, class Compare, class Access>
+		class btree{
+		private:
+			template<class V_, class Tree_>
+			friend class btree_iter;
+		public:
+			typedef Key key_type;
+			typedef Value value_type;
+			typedef Compare key_compare;
+			typedef Value& reference;
+			typedef const Value& const_reference;
+			typedef size_t size_type;
+			typedef Access access_type;
+			typedef btree_iter<Value, btree> iterator;
+		private:
+#ifndef BTREE_NODE_BYTES// -DBTREE_NODE_BYTES=n to try other sizes, see bench/BTreeBench.cpp
+#define BTREE_NODE_BYTES 256
+#endif
+			enum ESlots{
+				LEAF_SLOTS = (BTREE_NODE_BYTES / sizeof(Value) < 4 ? 4 : BTREE_NODE_BYTES / sizeof(Value)),
+				INNER_SLOTS = (BTREE_NODE_BYTES / (sizeof(Key) + sizeof(void *)) < 4 ?
+					4 : BTREE_NODE_BYTES / (sizeof(Key) + sizeof(void *)))
+			};
+			struct node{
+				bool leaf_;
+				size_t count_;// values in a leaf, keys in an inner node
+				explicit node(bool leaf) :leaf_(leaf), count_(0){}
+			};
+			struct leaf_node : public node{
+				leaf_node *prev_, *next_;
+				Value values_[LEAF_SLOTS];
+				leaf_node() :node(true), prev_(0), next_(0){}
+			};
+			// keys_[i] separates children_[i] (less than it) and children_[i + 1]
+			struct inner_node : public node{
+				Key keys_[INNER_SLOTS];
+				node *children_[INNER_SLOTS + 1];
+				inner_node() :node(false){}
+			};
+			typedef MySTL::allocator<leaf_node> leafAllocator;
+			typedef MySTL::allocator<inner_node> innerAllocator;
+		private:
+			node *root_;
+			leaf_node *head_, *tail_;
+			size_type size_;
+		public:
+			btree() :root_(0), head_(0), tail_(0), size_(0){}
+			btree(const btree&) = delete;
+			btree& operator = (const btree&) = delete;
+			~btree(){ clear(); }
+
+			size_type size()const{ return size_; }
+			bool empty()const{ return size_ == 0; }
+			size_type height()const;
+			iterator begin()const{ return iterator(head_, 0, this); }
+			iterator end()const{ return iterator(0, 0, this); }
+
+			iterator find(const key_type& key)const;
+			size_type count(const key_type& key)const{ return find(key) == end() ? 0 : 1; }
+			iterator lower_bound(const key_type& key)const;
+			iterator upper_bound(const key_type& key)const;
+			MySTL::pair<iterator, iterator> equal_range(const key_type& key)const{
+				return MySTL::make_pair(lower_bound(key), upper_bound(key));
+			}
+
+			MySTL::pair<iterator, bool> insert(const value_type& val);
+			template<class InputIterator>
+			void insert(InputIterator first, InputIterator last);
+			size_type erase(const key_type& key);
+			void erase(iterator position){ erase(KeyOfValue()(position.leaf_->values_[position.slot_])); }
+			void clear();
+		private:
+			leaf_node *new_leaf();
+			inner_node *new_inner();
+			void delete_leaf(leaf_node *leaf);
+			void delete_inner(inner_node *inner);
+			void destroy(node *p);
+
+			static bool less(const key_type& lhs, const key_type& rhs){ return Compare()(lhs, rhs); }
+			static size_t leaf_lower_bound(const leaf_node *leaf, const key_type& key);
+			static size_t leaf_upper_bound(const leaf_node *leaf, const key_type& key);
+			static size_t inner_upper_bound(const inner_node *inner, const key_type& key);
+			leaf_node *find_leaf(const key_type& key)const;
+			iterator make_iter(leaf_node *leaf, size_t slot)const;
+
+			bool insert_aux(node *p, const value_type& val, iterator& pos, key_type& split_key, node *&split_node);
+			bool erase_aux(node *p, const key_type& key);
+			void fix_child(inner_node *parent, size_t i);
+			void merge_leaves(inner_node *parent, size_t i);
+			void merge_inners(inner_node *parent, size_t i);
+			void remove_child(inner_node *parent, size_t i);
+		};
+	}// end of namespace Detail
+
+	// class of btree set, unique keys kept in order
+	template<class Key, class Compare = MySTL::less<Key>>
+	class btree_set{
+	private:
+		typedef Detail::btree<Key, Key, MySTL::identity<Key>, Compare> tree_type;
+	public:
+		typedef Key key_type;
+		typedef Key value_type;
+		typedef Compare key_compare;
+		typedef size_t size_type;
+		typedef typename tree_type::iterator iterator;// the values are read-only through it
+	private:
+		tree_type tree_;
+	public:
+		btree_set(){}
+		template<class InputIterator>
+		btree_set(InputIterator first, InputIterator last){ tree_.insert(first, last); }
+
+		size_type size()const{ return tree_.size(); }
+		bool empty()const{ return tree_.empty(); }
+		size_type height()const{ return tree_.height(); }
+		iterator begin()const{ return tree_.begin(); }
+		iterator end()const{ return tree_.end(); }
+
+		iterator find(const key_type& key)const{ return tree_.find(key); }
+		size_type count(const key_type& key)const{ return tree_.count(key); }
+		iterator lower_bound(const key_type& key)const{ return tree_.lower_bound(key); }
+		iterator upper_bound(const key_type& key)const{ return tree_.upper_bound(key); }
+		MySTL::pair<iterator, iterator> equal_range(const key_type& key)const{ return tree_.equal_range(key); }
+
+		MySTL::pair<iterator, bool> insert(const value_type& val){ return tree_.insert(val); }
+		template<class InputIterator>
+		void insert(InputIterator first, InputIterator last){ tree_.insert(first, last); }
+		size_type erase(const key_type& key){ return tree_.erase(key); }
+		void erase(iterator position){ tree_.erase(position); }
+		void clear(){ tree_.clear(); }
+	};
+
+	// class of btree map, unique keys kept in order with a mapped value each
+	template<class Key, class T, class Compare = MySTL::less<Key>>
+	class btree_map{
+	public:
+		typedef Key key_type;
+		typedef T mapped_type;
+		typedef MySTL::pair<Key, T> value_type;// an iterator shows it with a read-only key
+		typedef Compare key_compare;
+		typedef size_t size_type;
+	private:
+		typedef Detail::btree<Key, value_type, MySTL::select1st<value_type>, Compare, Detail::btree_map_access<Key, T>> tree_type;
+	public:
+		typedef typename tree_type::iterator iterator;
+	private:
+		tree_type tree_;
+	public:
+		btree_map(){}
+		template<class InputIterator>
+		btree_map(InputIterator first, InputIterator last){ tree_.insert(first, last); }
+
+		size_type size()const{ return tree_.size(); }
+		bool empty()const{ return tree_.empty(); }
+		size_type height()const{ return tree_.height(); }
+		iterator begin()const{ return tree_.begin(); }
+		iterator end()const{ return tree_.end(); }
+
+		iterator find(const key_type& key)const{ return tree_.find(key); }
+		size_type count(const key_type& key)const{ return tree_.count(key); }
+		iterator lower_bound(const key_type& key)const{ return tree_.lower_bound(key); }
+		iterator upper_bound(const key_type& key)const{ return tree_.upper_bound(key); }
+		MySTL::pair<iterator, iterator> equal_range(const key_type& key)const{ return tree_.equal_range(key); }
+
+		mapped_type& operator[](const key_type& key){ return tree_.insert(value_type(key, mapped_type())).first->second; }
+		MySTL::pair<iterator, bool> insert(const value_type& val){ return tree_.insert(val); }
+		template<class InputIterator>
+		void insert(InputIterator first, InputIterator last){ tree_.insert(first, last); }
+		size_type erase(const key_type& key){ return tree_.erase(key); }
+		void erase(iterator position){ tree_.erase(position); }
+		void clear(){ tree_.clear(); }
+	};
+}// end of namespace MySTL
+
+#include "BTree.impl.h"
+#endif
\ No newline at end of file
@@ -3,11 +3,11 @@
 
 #include "Allocator.h"
 #include "Iterator.h"
+#include "NodePool.h"
 #include "Queue.h"
-#include "Stack.h"
 #include "String.h"
 
-#include <set>
+#include <deque>
 #include <iostream>
 
 namespace MySTL{
@@ -17,21 +17,29 @@ namespace MySTL{
 	}
 
 	// class of binary_search_tree
-	template<class T>
+	// NodeStorage is heap_node_storage or pooled_node_storage, see NodePool.h
+	// a tree built with balanced = true is kept as a treap: each node gets a random
+	// priority and rotations keep the priorities in heap order, so the expected depth
+	// is O(log n) whatever the insertion order
+	template<class T, class NodeStorage = MySTL::heap_node_storage>
 	class binary_search_tree{
 	private:
-		template<class T>
+		template<class T_>
 		friend class Detail::bst_iter;
 	private:
 		struct node{
 			typedef T value_type;
+			typedef binary_search_tree tree_type;
 			T data_;
 			node *left_;
 			node *right_;
-			explicit node(T d = T(), node *l = 0, node *r = 0)
-				:data_(d), left_(l), right_(r){}
+			node *parent_;
+			unsigned int priority_;// only used in balanced mode
+			explicit node(T d = T(), node *l = 0, node *r = 0, node *p = 0)
+				:data_(d), left_(l), right_(r), parent_(p), priority_(0){}
 		};
-		typedef MySTL::allocator<node> nodeAllocator;
+		typedef MySTL::allocator<node> nodeAllocator;// constructs and destroys in place
+		typedef typename NodeStorage::template storage<node> storage_type;
 	public:
 		typedef T value_type;
 		typedef Detail::bst_iter<node> const_iterator;
@@ -40,8 +48,12 @@ namespace MySTL{
 	private:
 		node *root_;
 		size_t size_;
+		storage_type storage_;
+		bool balanced_;
+		unsigned long long seed_;// for the priorities
 	public:
-		binary_search_tree() :root_(0), size_(0){}
+		explicit binary_search_tree(bool balanced = false)
+			:root_(0), size_(0), balanced_(balanced), seed_(0x9E3779B97F4A7C15ull){}
 		binary_search_tree(const binary_search_tree&) = delete;// ǳ͸
 		binary_search_tree& operator=(const binary_search_tree&) = delete;
 		~binary_search_tree();
@@ -50,14 +62,16 @@ namespace MySTL{
 		template<class Iterator>
 		void insert(Iterator first, Iterator last);
 		void erase(const T& val);
+		void compact();// moves the nodes into fresh storage in in-order sequence
 
 		bool empty() const { return root_ == 0; }
+		bool balanced() const { return balanced_; }
 		size_t size() const { return size_; }
 		size_t height() const{ return height_aux(root_); }
-		const_iterator root() const{ return const_iterator(root_, this); }
+		const_iterator root() const{ return const_iterator(root_); }
 
 		const_iterator cbegin()const{ return find_min(); }
-		const_iterator cend()const{ return const_iterator(0, this); }
+		const_iterator cend()const{ return const_iterator(); }
 
 		const_iterator find_min()const;
 		const_iterator find_max()const;
@@ -72,7 +86,11 @@ namespace MySTL{
 		void deallocateAllNodes(node *ptr);
 		size_t height_aux(node *p)const;
 		void erase_elem(const T& val, node *&ptr);
-		void insert_elem(const T& val, node *&ptr);
+		void insert_elem(const T& val, node *&ptr, node *parent);
+		void rotate_left(node *&ptr);
+		void rotate_right(node *&ptr);
+		unsigned int next_priority();
+		node *compact_aux(node *p, storage_type& fresh);
 		const_iterator find_min_aux(const node *ptr)const;
 		const_iterator find_max_aux(const node *ptr)const;
 		const_iterator find_aux(const T& val, const node *ptr)const;
@@ -83,39 +101,36 @@ namespace MySTL{
 
 	namespace Detail{
 		// class of bst iterator
+		// a node pointer only, ++ follows the parent pointers
 		template<class T>// T = node
 		class bst_iter :
-			public iterator<forward_iterator_tag, typename ::MySTL::binary_search_tree<typename T::value_type>::value_type>{
+			public iterator<forward_iterator_tag, typename T::tree_type::value_type>{
 		private:
-			template<class T>
+			template<class T_, class NodeStorage_>
 			friend class ::MySTL::binary_search_tree;
 		private:
-			typedef typename ::MySTL::binary_search_tree<typename T::value_type>::const_reference const_reference;
-			typedef typename const T::value_type *const_pointer;
-			typedef const ::MySTL::binary_search_tree<typename T::value_type> * cntrPtr;
+			typedef typename T::tree_type::const_reference const_reference;
+			typedef const typename T::value_type *const_pointer;
 		private:
 			const T *ptr_;
-			cntrPtr container_;
-			stack<const T *> parent_;// rootptr_ĸڵ·
-			std::set<const T *> visited_;// ǰڵǷ񱻷ʹnode˵ѱˣ
 
 		public:
-			bst_iter(const T *ptr, cntrPtr container);
+			explicit bst_iter(const T *ptr = 0) :ptr_(ptr){}
 
 			operator const T*(){ return ptr_; }
 			const_reference operator*()const{ return ptr_->data_; }
 			const_pointer operator ->()const{ return &(operator*()); }
 
-			bst_iter left()const{ return bst_iter(ptr_->left_, container_); }
-			bst_iter right()const{ return bst_iter(ptr_->right_, container_); }
+			bst_iter left()const{ return bst_iter(ptr_->left_); }
+			bst_iter right()const{ return bst_iter(ptr_->right_); }
 
 			bst_iter& operator ++();
 			bst_iter operator ++(int);
 		public:
-			template<class T>
-			friend bool operator ==(const bst_iter<T>& it1, const bst_iter<T>& it2);
-			template<class T>
-			friend bool operator !=(const bst_iter<T>& it1, const bst_iter<T>& it2);
+			template<class T_>
+			friend bool operator ==(const bst_iter<T_>& it1, const bst_iter<T_>& it2);
+			template<class T_>
+			friend bool operator !=(const bst_iter<T_>& it1, const bst_iter<T_>& it2);
 		};// end of bst_iter
 	}
 }
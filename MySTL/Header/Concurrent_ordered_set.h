@@ -0,0 +1,160 @@
+#ifndef _CONCURRENT_ORDERED_SET_H_
+#define _CONCURRENT_ORDERED_SET_H_
+
+#include "Allocator.h"
+#include "Functional.h"
+#include "Iterator.h"
+#include "Vector.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace MySTL{
+	template<class Key, class Compare>
+	class concurrent_ordered_set;
+
+	namespace Detail{
+		// stripes the calling thread is counted on, a writer that is also a reader
+		// must not wait for the stripes to drain
+		inline int& entered_stripes(){
+			static thread_local int entered = 0;
+			return entered;
+		}
+		// a reader of a concurrent_ordered_set is counted on one of these while it may
+		// hold a node pointer, a writer frees an unlinked node only after it has seen
+		// every stripe empty at some moment since the unlink
+		struct reader_stripe{
+			std::atomic<int> readers_;
+			char padding_[64];// keep two stripes off the same cache line
+			reader_stripe() :readers_(0){}
+			void enter(){
+				++entered_stripes();
+				readers_.fetch_add(1);
+				std::atomic_thread_fence(std::memory_order_seq_cst);//pairs with the fence in reclaim
+			}
+			void leave(){
+				readers_.fetch_sub(1);
+				--entered_stripes();
+			}
+		};
+
+		// class of concurrent_ordered_set iterator
+		// keeps its stripe entered for as long as it lives, so the node it points to
+		// stays valid even if it is erased meanwhile
+		template<class Node>
+		class cos_iter : public iterator<forward_iterator_tag, typename Node::value_type>{
+		private:
+			template<class K_, class Cmp_>
+			friend class ::MySTL::concurrent_ordered_set;
+		private:
+			typedef typename Node::value_type value_type;
+		private:
+			const Node *ptr_;
+			reader_stripe *stripe_;
+		public:
+			cos_iter() :ptr_(0), stripe_(0){}
+			cos_iter(const cos_iter& it) :ptr_(it.ptr_), stripe_(it.stripe_){ if (stripe_) stripe_->enter(); }
+			~cos_iter(){ if (stripe_) stripe_->leave(); }
+			cos_iter& operator = (const cos_iter& it);
+
+			const value_type& operator*()const{ return ptr_->key_; }
+			const value_type* operator->()const{ return &(operator*()); }
+			cos_iter& operator ++(){
+				ptr_ = ptr_->next_[0].load(std::memory_order_acquire);
+				return *this;
+			}
+			cos_iter operator ++(int){
+				auto res = *this;
+				++*this;
+				return res;
+			}
+			bool operator ==(const cos_iter& it)const{ return ptr_ == it.ptr_; }
+			bool operator !=(const cos_iter& it)const{ return ptr_ != it.ptr_; }
+		private:
+			explicit cos_iter(reader_stripe *stripe) :ptr_(0), stripe_(stripe){ stripe_->enter(); }
+		};
+	}// end of namespace Detail
+
+	// class of concurrent_ordered_set
+	// a skip list in which lookups and iteration never lock: every link is an atomic
+	// pointer published with release stores, writers are serialized by a mutex and
+	// unlinked nodes are retired until no reader can still reach them. Iteration is
+	// in ascending order like avl_tree and sees each link as it was when followed
+	// once RETIRE_LIMIT nodes wait to be freed, a writer blocks until the readers
+	// of the moment are gone, so a long-lived iterator held by another thread stalls
+	// erase; a thread that holds an iterator itself never blocks, its erases keep
+	// the retired nodes until a later write finds the readers gone
+	template<class Key, class Compare = MySTL::less<Key>>
+	class concurrent_ordered_set{
+	private:
+		template<class Node_>
+		friend class Detail::cos_iter;
+	public:
+		typedef Key key_type;
+		typedef Key value_type;
+		typedef Compare key_compare;
+		typedef size_t size_type;
+
+	private:
+#define SKIPLIST_MAX_LEVEL 24
+#define READER_STRIPES 16
+#define RETIRE_LIMIT 1024 // unlinked nodes kept before a writer waits for the readers
+		struct node{
+			typedef Key value_type;
+			Key key_;
+			size_t level_;
+			std::atomic<node *> *next_;// level_ forward links, next_[0] is the ordered list
+			node(const Key& key, size_t level) :key_(key), level_(level), next_(0){}
+		};
+		typedef MySTL::allocator<node> nodeAllocator;
+		typedef MySTL::allocator<std::atomic<node *>> linkAllocator;
+
+	public:
+		typedef Detail::cos_iter<node> const_iterator;
+
+	private:
+		node *head_;
+		std::atomic<size_t> level_;// levels in use
+		std::atomic<size_type> size_;
+		std::mutex writer_;
+		unsigned long long seed_;// for random levels, writer only
+		vector<node *> retired_;// unlinked after limbo_ was started
+		vector<node *> limbo_;// unlinked, waiting for every stripe to be seen empty
+		unsigned int limbo_seen_;// bit i set once stripe i was seen empty
+		mutable Detail::reader_stripe stripes_[READER_STRIPES];
+
+	public:
+		concurrent_ordered_set();
+		concurrent_ordered_set(const concurrent_ordered_set&) = delete;
+		concurrent_ordered_set& operator= (const concurrent_ordered_set&) = delete;
+		~concurrent_ordered_set();
+
+		size_type size()const{ return size_.load(); }
+		bool empty()const{ return size() == 0; }
+
+		size_type count(const key_type& key)const;
+		const_iterator find(const key_type& key)const;
+		const_iterator lower_bound(const key_type& key)const;
+		const_iterator cbegin()const;
+		const_iterator cend()const{ return const_iterator(); }
+		// visit the values in ascending order
+		template<class Function>
+		Function for_each(Function fn)const;
+
+		bool insert(const value_type& val);
+		size_type erase(const key_type& key);
+
+	private:
+		Detail::reader_stripe& stripe()const;
+		node *new_node(const Key& key, size_t level);
+		void delete_node(node *p);
+		size_t random_level();
+		const node *lower_bound_node(const key_type& key)const;
+		node *find_preds(const key_type& key, node **preds);
+		void reclaim();
+		void reclaim_step();
+	};
+}// end of namespace MySTL
+
+#include "Concurrent_ordered_set.impl.h"
+#endif
\ No newline at end of file
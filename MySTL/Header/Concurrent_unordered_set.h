@@ -0,0 +1,100 @@
+#ifndef _CONCURRENT_UNORDERED_SET_H_
+#define _CONCURRENT_UNORDERED_SET_H_
+
+#include "Allocator.h"
+#include "Functional.h"
+#include "Unordered_set.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace MySTL{
+	namespace Detail{
+		// writer-preferring reader/writer lock
+		// readers only touch an atomic counter, writers are serialized by a mutex and
+		// wait for the readers already inside to leave
+		class rw_lock{
+		private:
+			std::mutex writer_;
+			std::atomic<bool> writing_;
+			std::atomic<int> readers_;
+		public:
+			rw_lock() :writing_(false), readers_(0){}
+			rw_lock(const rw_lock&) = delete;
+			rw_lock& operator= (const rw_lock&) = delete;
+
+			void lock_shared();
+			void unlock_shared(){ readers_.fetch_sub(1); }
+			void lock();
+			void unlock();
+		};
+	}// end of namespace Detail
+
+	// class of concurrent_unordered_set
+	// the elements are spread over a power-of-two number of shards, each one an
+	// Unordered_set guarded by its own rw_lock, so that lookups only contend with
+	// writers of the same shard. The shard is chosen by the high bits of the mixed
+	// hash while the shard's own buckets are chosen by its bucket policy, so the
+	// two stay independent
+	template<class Key, class Hash = std::hash<Key>,
+	class KeyEqual = MySTL::equal_to<Key>, class Allocator = MySTL::allocator<Key>,
+	class BucketPolicy = MySTL::prime_bucket_policy>
+	class concurrent_unordered_set{
+	public:
+		typedef Key key_type;
+		typedef Key value_type;
+		typedef size_t size_type;
+		typedef Hash haser;
+		typedef KeyEqual key_equal;
+		typedef Allocator allocator_type;
+		typedef BucketPolicy bucket_policy;
+
+	private:
+		struct shard{
+			Detail::rw_lock lock_;
+			// incremental rehash is never turned on here: with it off find() does not
+			// modify the set and is safe to run under the shared lock
+			Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy> set_;
+			char padding_[64];// keep the locks of two shards off the same cache line
+			explicit shard(size_type bucket_count = 0) :set_(bucket_count){}
+		};
+		typedef MySTL::allocator<shard> shardAllocator;
+
+	private:
+		shard *shards_;
+		size_type shard_count_;
+		size_type shard_shift_;
+
+	public:
+		explicit concurrent_unordered_set(size_type bucket_count, size_type shard_count = 16);
+		concurrent_unordered_set(const concurrent_unordered_set&) = delete;
+		concurrent_unordered_set& operator= (const concurrent_unordered_set&) = delete;
+		~concurrent_unordered_set();
+
+		// size() and empty() lock the shards one after another, so under concurrent
+		// writers they only give a snapshot
+		size_type size()const;
+		bool empty()const{ return size() == 0; }
+		size_type shard_count()const{ return shard_count_; }
+
+		size_type count(const key_type& key)const;
+		// call fn(element) under the shard's shared lock if key is present
+		template<class Function>
+		bool find(const key_type& key, Function fn)const;
+		bool insert(const value_type& val);
+		size_type erase(const key_type& key);
+		// visit every element, one shard at a time under its shared lock
+		template<class Function>
+		Function for_each(Function fn)const;
+
+		haser hash_function()const{ return haser(); }
+		key_equal key_eq()const{ return key_equal(); }
+		allocator_type get_allocator()const{ return allocator_type(); }
+
+	private:
+		shard& shard_of(const key_type& key)const;
+	};
+}// end of namespace MySTL
+
+#include "Concurrent_unordered_set.impl.h"
+#endif
\ No newline at end of file
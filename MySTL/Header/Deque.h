@@ -15,7 +15,7 @@ namespace MySTL{
 		template<class T>
 		class dq_iter : public iterator<bidirectional_iterator_tag, T>{
 		private:
-			template<class T, class Alloc>
+			template<class T_, class Alloc_>
 			friend class ::MySTL::deque;
 		private:
 			typedef const ::MySTL::deque<T>* cntrPtr;
@@ -30,10 +30,10 @@ namespace MySTL{
 				:mapIndex_(it.mapIndex_), cur_(it.cur_), container_(it.container_){}
 			dq_iter& operator = (const dq_iter& it);
 			void swap(dq_iter& it);
-			reference operator *(){ return *cur_; }
-			const reference operator *()const{ return *cur_; }
-			pointer operator ->(){ return &(operator*()); }
-			const pointer operator ->()const{ return &(operator*()); }
+			T& operator *(){ return *cur_; }
+			T& operator *()const{ return *cur_; }
+			T* operator ->(){ return &(operator*()); }
+			T* operator ->()const{ return &(operator*()); }
 			dq_iter& operator ++();
 			dq_iter operator ++(int);
 			dq_iter& operator --();
@@ -45,18 +45,18 @@ namespace MySTL{
 			T *getBuckHead(size_t mapIndex) const;
 			size_t getBuckSize() const;
 		public:
-			template<class T>
-			friend dq_iter<T> operator + (const dq_iter<T>& it, typename dq_iter<T>::difference_type n);
-			template<class T>
-			friend dq_iter<T> operator + (typename dq_iter<T>::difference_type n, const dq_iter<T>& it);
-			template<class T>
-			friend dq_iter<T> operator - (const dq_iter<T>& it, typename dq_iter<T>::difference_type n);
-			template<class T>
-			friend dq_iter<T> operator - (typename dq_iter<T>::difference_type n, const dq_iter<T>& it);
-			template<class T>
-			friend typename dq_iter<T>::difference_type operator - (const dq_iter<T>& it1, const dq_iter<T>& it2);
-			template<class T>
-			friend void swap(dq_iter<T>& lhs, dq_iter<T>& rhs);
+			template<class T_>
+			friend dq_iter<T_> operator + (const dq_iter<T_>& it, typename dq_iter<T_>::difference_type n);
+			template<class T_>
+			friend dq_iter<T_> operator + (typename dq_iter<T_>::difference_type n, const dq_iter<T_>& it);
+			template<class T_>
+			friend dq_iter<T_> operator - (const dq_iter<T_>& it, typename dq_iter<T_>::difference_type n);
+			template<class T_>
+			friend dq_iter<T_> operator - (typename dq_iter<T_>::difference_type n, const dq_iter<T_>& it);
+			template<class T_>
+			friend typename dq_iter<T_>::difference_type operator - (const dq_iter<T_>& it1, const dq_iter<T_>& it2);
+			template<class T_>
+			friend void swap(dq_iter<T_>& lhs, dq_iter<T_>& rhs);
 		}; // end of dq_iter
 	} // end of detail namespace
 
@@ -64,7 +64,7 @@ namespace MySTL{
 	template<class T, class Alloc>
 	class deque{
 	private:
-		template<class T>
+		template<class T_>
 		friend class ::MySTL::Detail::dq_iter;
 	public:
 		typedef T value_type;
@@ -128,12 +128,12 @@ namespace MySTL{
 		void deque_aux(Iterator first, Iterator last, std::false_type);
 		void reallocateAndCopy();
 	public:
-		template<class T, class Alloc>
-		friend bool operator== (const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs);
-		template<class T, class Alloc>
-		friend bool operator!= (const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs);
-		template <class T, class Alloc>
-		friend void swap(const deque<T, Alloc>& x, const deque<T, Alloc>& y);
+		template<class T_, class Alloc_>
+		friend bool operator== (const deque<T_, Alloc_>& lhs, const deque<T_, Alloc_>& rhs);
+		template<class T_, class Alloc_>
+		friend bool operator!= (const deque<T_, Alloc_>& lhs, const deque<T_, Alloc_>& rhs);
+		template <class T_, class Alloc_>
+		friend void swap(const deque<T_, Alloc_>& x, const deque<T_, Alloc_>& y);
 	}; // end of deque
 }
 
@@ -0,0 +1,68 @@
+#ifndef _EYTZINGER_ARRAY_H_
+#define _EYTZINGER_ARRAY_H_
+
+#include "Algorithm.h"
+#include "Construct.h"
+#include "Functional.h"
+#include "Utility.h"
+#include "Vector.h"
+
+namespace MySTL{
+	// class of eytzinger_array
+	// a static sorted set kept in the breadth first order of a complete binary search
+	// tree, node k (from 1) has the children 2k and 2k + 1: the top levels that every
+	// search walks share a few cache lines, and the 16 or so nodes four levels below one
+	// are side by side, so their line is prefetched while those levels are compared.
+	// Lookups in an array larger than the cache wait on far fewer misses than a binary
+	// search of the sorted array, the price is that the values can't be changed.
+	// Node k is stored at slot k of a 64-byte aligned block, so the 16 (for 4-byte values)
+	// grandchildren 16k ... 16k + 15 four levels down fill exactly one cache line
+	template<class T, class Compare = MySTL::less<T>>
+	class eytzinger_array{
+	public:
+		typedef T value_type;
+		typedef Compare value_compare;
+		typedef const T& const_reference;
+		typedef const T *const_iterator;// walks the tree order, not the sorted order
+		typedef size_t size_type;
+	private:
+		enum{ PREFETCH_STRIDE = sizeof(T) < 64 ? 64 / sizeof(T) : 1 };// nodes of a cache line
+		enum{ CACHE_LINE = 64 };
+	private:
+		void *buffer_;// the allocation, tree_ is aligned within it
+		T *tree_;// node k is tree_[k], tree_[0] holds no value
+		size_type size_;
+		value_compare comp_;
+	public:
+		eytzinger_array() :buffer_(0), tree_(0), size_(0){}
+		// the values come in any order, repeated ones are kept once
+		template<class InputIterator>
+		eytzinger_array(InputIterator first, InputIterator last, value_compare comp = value_compare());
+		eytzinger_array(const eytzinger_array& other);
+		eytzinger_array(eytzinger_array&& other);
+		eytzinger_array& operator = (eytzinger_array other);
+		~eytzinger_array();
+
+		size_type size()const{ return size_; }
+		bool empty()const{ return size_ == 0; }
+		const_iterator begin()const{ return tree_ + (size_ != 0 ? 1 : 0); }
+		const_iterator end()const{ return begin() + size_; }
+		value_compare value_comp()const{ return comp_; }
+
+		// least value not less than val, end() if there is none
+		const_iterator lower_bound(const value_type& val)const;
+		// least value greater than val, end() if there is none
+		const_iterator upper_bound(const value_type& val)const;
+		const_iterator find(const value_type& val)const;
+		size_type count(const value_type& val)const{ return find(val) == end() ? 0 : 1; }
+		void swap(eytzinger_array& other);
+	private:
+		void allocate(size_type n);
+		size_type build(const vector<T>& sorted, size_type i, size_type k);
+		template<bool Upper>
+		const_iterator search(const value_type& val)const;
+	};
+}
+
+#include "EytzingerArray.impl.h"
+#endif
\ No newline at end of file
@@ -25,6 +25,34 @@ namespace MySTL{
 			return x == y;
 		}
 	};
+
+	//************ [plus] *************
+	template<class T>
+	struct plus{
+		typedef T first_arguement_type;
+		typedef T second_arguement_type;
+		typedef T result_type;
+
+		result_type operator()(const first_arguement_type& x, const second_arguement_type& y)const{
+			return x + y;
+		}
+	};
+
+	//************ [identity] *************
+	template<class T>
+	struct identity{
+		const T& operator()(const T& x)const{
+			return x;
+		}
+	};
+
+	//************ [select1st] *************
+	template<class Pair>
+	struct select1st{
+		const typename Pair::first_type& operator()(const Pair& x)const{
+			return x.first;
+		}
+	};
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,152 @@
+#ifndef _HASH_SNAPSHOT_H_
+#define _HASH_SNAPSHOT_H_
+
+#include "Functional.h"
+#include "String.h"
+#include "Unordered_set.h"
+#include "Vector.h"
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace MySTL{
+	// read-only memory mapping of a whole file
+	class mapped_file{
+	private:
+		const char *data_;
+		size_t size_;
+		void *handle_;// the file mapping object on windows, unused elsewhere
+	public:
+		mapped_file() :data_(0), size_(0), handle_(0){}
+		mapped_file(const mapped_file&) = delete;
+		mapped_file& operator= (const mapped_file&) = delete;
+		~mapped_file(){ close(); }
+
+		bool open(const char *path);
+		void close();
+		bool is_open()const{ return data_ != 0; }
+		const char *data()const{ return data_; }
+		size_t size()const{ return size_; }
+	};
+
+	/*
+	* snapshot file layout, every section starts on an 8-byte boundary:
+	* snapshot_header
+	* uint64_t bucket_offsets[bucket_count + 1]	// entries of bucket i are [offsets[i], offsets[i + 1])
+	* entry_type entries[size]						// grouped by bucket
+	* char pool[pool_size]							// string bytes, empty for trivially copyable keys
+	* The buckets are placed with Hash and BucketPolicy, so a snapshot must be read
+	* with the same hash function it was written with. The header records the
+	* policy id, the byte order and the width of size_t of the writer, and a
+	* snapshot written with any other is rejected
+	*/
+	namespace Detail{
+		struct snapshot_header{
+			char magic_[8];
+			uint32_t version_;
+			uint32_t entry_size_;
+			uint32_t policy_id_;
+			uint8_t little_endian_;
+			uint8_t size_t_width_;
+			uint16_t reserved_;
+			uint64_t bucket_count_;
+			uint64_t size_;
+			uint64_t pool_size_;
+		};
+
+		// how a key is stored in the entries section
+		template<class Key>
+		struct snapshot_traits{
+			static_assert(std::is_trivially_copyable<Key>::value, "snapshot keys must be trivially copyable");
+			typedef Key entry_type;
+			static entry_type make_entry(const Key& key, MySTL::vector<char>& pool){ return key; }
+			static bool valid(const entry_type& entry, uint64_t pool_size){ return true; }
+			template<class KeyEqual>
+			static bool equal(const entry_type& entry, const char *pool, const Key& key){
+				return KeyEqual()(key, entry);
+			}
+		};
+
+		// strings are stored as (offset, length) into the pool
+		template<>
+		struct snapshot_traits<MySTL::string>{
+			struct entry_type{
+				uint64_t offset_;
+				uint64_t length_;
+			};
+			static entry_type make_entry(const MySTL::string& key, MySTL::vector<char>& pool){
+				entry_type entry = { (uint64_t)pool.size(), (uint64_t)key.size() };
+				pool.insert(pool.end(), key.begin(), key.end());
+				return entry;
+			}
+			static bool valid(const entry_type& entry, uint64_t pool_size){
+				return entry.length_ <= pool_size && entry.offset_ <= pool_size - entry.length_;
+			}
+			// plain equality compares the pool bytes in place, any other KeyEqual is
+			// given the stored key as a string
+			template<class KeyEqual>
+			static bool equal(const entry_type& entry, const char *pool, const MySTL::string& key){
+				if (std::is_same<KeyEqual, MySTL::equal_to<MySTL::string>>::value)
+					return entry.length_ == key.size() &&
+						(key.size() == 0 || memcmp(pool + entry.offset_, key.begin(), key.size()) == 0);
+				return KeyEqual()(key, MySTL::string(pool + entry.offset_, (size_t)entry.length_));
+			}
+		};
+	}// end of namespace Detail
+
+	// write the elements of set as a snapshot file, returns false on an io error
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	bool write_snapshot(Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>& set, const char *path);
+
+	// class of hash_set_snapshot
+	// read-only hash set answering lookups straight from a mapped snapshot file,
+	// nothing is deserialized or allocated when it is opened
+	template<class Key, class Hash = std::hash<Key>,
+	class KeyEqual = MySTL::equal_to<Key>, class BucketPolicy = MySTL::prime_bucket_policy>
+	class hash_set_snapshot{
+	public:
+		typedef Key key_type;
+		typedef Key value_type;
+		typedef size_t size_type;
+		typedef Hash haser;
+		typedef KeyEqual key_equal;
+
+	private:
+		typedef Detail::snapshot_traits<Key> traits;
+		typedef typename traits::entry_type entry_type;
+
+	private:
+		mapped_file file_;
+		const Detail::snapshot_header *header_;
+		const uint64_t *offsets_;
+		const entry_type *entries_;
+		const char *pool_;
+
+	public:
+		hash_set_snapshot() :header_(0), offsets_(0), entries_(0), pool_(0){}
+		hash_set_snapshot(const hash_set_snapshot&) = delete;
+		hash_set_snapshot& operator= (const hash_set_snapshot&) = delete;
+
+		// map the file and check its header, bucket offsets and entries, returns false
+		// if it is not a valid snapshot, the checks read the whole file once
+		bool open(const char *path);
+		void close();
+		bool is_open()const{ return header_ != 0; }
+
+		size_type size()const{ return header_ == 0 ? 0 : (size_type)header_->size_; }
+		bool empty()const{ return size() == 0; }
+		size_type bucket_count()const{ return header_ == 0 ? 0 : (size_type)header_->bucket_count_; }
+		bool contains(const key_type& key)const;
+		size_type count(const key_type& key)const{ return contains(key) ? 1 : 0; }
+
+		haser hash_function()const{ return haser(); }
+		key_equal key_eq()const{ return key_equal(); }
+
+	private:
+		static bool check(const char *data, size_t size);
+	};
+}// end of namespace MySTL
+
+#include "HashSnapshot.impl.h"
+#endif
\ No newline at end of file
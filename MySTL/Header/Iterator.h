@@ -1,6 +1,8 @@
 #ifndef _ITERATOR_H_
 #define _ITERATOR_H_
 
+#include <cstddef>
+
 namespace MySTL{
 	struct input_iterator_tag{};
 	struct output_iterator_tag{};
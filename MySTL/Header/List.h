@@ -28,7 +28,7 @@ namespace MySTL{
 
 		template<class T>
 		struct listIterator : public iterator<bidirectional_iterator_tag, T>{
-			template<class T>
+			template<class T_>
 			friend class list;
 		public:
 			typedef node<T>* nodePtr;
@@ -43,9 +43,9 @@ namespace MySTL{
 			T& operator *() { return p->data; }
 			T* operator ->(){ return &(operator*()); }
 
-			template<class T>
+			template<class T_>
 			friend bool operator ==(const listIterator& lhs, const listIterator& rhs);
-			template<class T>
+			template<class T_>
 			friend bool operator !=(const listIterator& lhs, const listIterator& rhs);
 		};// end of listIterator
 	}// end of detail namespace
@@ -53,7 +53,7 @@ namespace MySTL{
 	// class of list
 	template<class T>
 	class list{
-		template<class  T>
+		template<class  T_>
 		friend struct listIterator;
 	private:
 		typedef allocator<Detail::node<T>> nodeAllocator;
@@ -130,12 +130,12 @@ namespace MySTL{
 		void insert_aux(iterator position, InputIterator first, InputIterator last, std::false_type);
 		const_iterator changeIteratorToConstIterator(iterator& it)const;
 	public:
-		template<class T>
-		friend void swap(list<T>& x, list<T>& y);
-		template <class T>
-		friend bool operator== (const list<T>& lhs, const list<T>& rhs);
-		template <class T>
-		friend bool operator!= (const list<T>& lhs, const list<T>& rhs);
+		template<class T_>
+		friend void swap(list<T_>& x, list<T_>& y);
+		template <class T_>
+		friend bool operator== (const list<T_>& lhs, const list<T_>& rhs);
+		template <class T_>
+		friend bool operator!= (const list<T_>& lhs, const list<T_>& rhs);
 	}; //end of list
 }
 
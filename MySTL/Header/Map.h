@@ -0,0 +1,73 @@
+#ifndef _MAP_H_
+#define _MAP_H_
+
+#include "AVLTree.h"
+#include "Functional.h"
+#include "Utility.h"
+
+namespace MySTL{
+	namespace Detail{
+		// order (key, value) pairs by key only, a bare key may stand on either side
+		// so that lookups never build a pair
+		template<class Key, class T, class Compare>
+		struct map_compare{
+			bool operator()(const MySTL::pair<Key, T>& lhs, const MySTL::pair<Key, T>& rhs)const{
+				return Compare()(lhs.first, rhs.first);
+			}
+			bool operator()(const Key& key, const MySTL::pair<Key, T>& val)const{ return Compare()(key, val.first); }
+			bool operator()(const MySTL::pair<Key, T>& val, const Key& key)const{ return Compare()(val.first, key); }
+		};
+	}// end of namespace Detail
+
+	// class of map
+	// an ordered (key, value) mapping kept balanced by avl_tree
+	template<class Key, class T, class Compare = MySTL::less<Key>, class NodeStorage = MySTL::heap_node_storage>
+	class map{
+	public:
+		typedef Key key_type;
+		typedef T mapped_type;
+		typedef MySTL::pair<Key, T> value_type;
+		typedef Compare key_compare;
+		typedef size_t size_type;
+
+	private:
+		typedef avl_tree<value_type, Detail::map_compare<Key, T, Compare>, NodeStorage> tree_type;
+
+	public:
+		typedef typename tree_type::const_iterator const_iterator;
+		typedef const_iterator iterator;// read-only, a mapped value is modified through operator[]
+
+	private:
+		tree_type tree_;
+
+	public:
+		map(){}
+		template<class InputIterator>
+		map(InputIterator first, InputIterator last){ insert(first, last); }
+
+		size_type size()const{ return tree_.size(); }
+		bool empty()const{ return tree_.empty(); }
+		const_iterator begin()const{ return tree_.cbegin(); }
+		const_iterator end()const{ return tree_.cend(); }
+
+		const_iterator find(const key_type& key)const{ return tree_.find(key); }
+		size_type count(const key_type& key)const{ return find(key) == end() ? 0 : 1; }
+		const_iterator lower_bound(const key_type& key)const{ return tree_.lower_bound(key); }
+		const_iterator upper_bound(const key_type& key)const{ return tree_.upper_bound(key); }
+		MySTL::pair<const_iterator, const_iterator> equal_range(const key_type& key)const{
+			return tree_.equal_range(key);
+		}
+		const_iterator select(size_type k)const{ return tree_.select(k); }
+		size_type rank(const key_type& key)const{ return tree_.rank(key); }
+
+		mapped_type& operator[](const key_type& key);
+		MySTL::pair<const_iterator, bool> insert(const value_type& val);
+		template<class InputIterator>
+		void insert(InputIterator first, InputIterator last);
+		size_type erase(const key_type& key){ return tree_.erase(key); }
+		void compact(){ tree_.compact(); }
+	};
+}// end of namespace MySTL
+
+#include "Map.impl.h"
+#endif
\ No newline at end of file
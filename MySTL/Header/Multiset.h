@@ -0,0 +1,58 @@
+#ifndef _MULTISET_H_
+#define _MULTISET_H_
+
+#include "AVLTree.h"
+#include "Functional.h"
+#include "Utility.h"
+
+namespace MySTL{
+	// class of multiset
+	// an ordered collection that keeps equal values, kept balanced by avl_tree
+	template<class T, class Compare = MySTL::less<T>, class NodeStorage = MySTL::heap_node_storage>
+	class multiset{
+	public:
+		typedef T key_type;
+		typedef T value_type;
+		typedef Compare key_compare;
+		typedef size_t size_type;
+
+	private:
+		typedef avl_tree<T, Compare, NodeStorage> tree_type;
+
+	public:
+		typedef typename tree_type::const_iterator const_iterator;
+		typedef const_iterator iterator;
+
+	private:
+		tree_type tree_;
+
+	public:
+		multiset(){}
+		template<class InputIterator>
+		multiset(InputIterator first, InputIterator last){ insert(first, last); }
+
+		size_type size()const{ return tree_.size(); }
+		bool empty()const{ return tree_.empty(); }
+		const_iterator begin()const{ return tree_.cbegin(); }
+		const_iterator end()const{ return tree_.cend(); }
+
+		const_iterator find(const key_type& key)const{ return tree_.find(key); }
+		size_type count(const key_type& key)const;
+		const_iterator lower_bound(const key_type& key)const{ return tree_.lower_bound(key); }
+		const_iterator upper_bound(const key_type& key)const{ return tree_.upper_bound(key); }
+		MySTL::pair<const_iterator, const_iterator> equal_range(const key_type& key)const{
+			return tree_.equal_range(key);
+		}
+		const_iterator select(size_type k)const{ return tree_.select(k); }
+		size_type rank(const key_type& key)const{ return tree_.rank(key); }
+
+		void insert(const value_type& val){ tree_.insert_equal(val); }
+		template<class InputIterator>
+		void insert(InputIterator first, InputIterator last);
+		size_type erase(const key_type& key);// erases every value equal to key
+		void compact(){ tree_.compact(); }
+	};
+}// end of namespace MySTL
+
+#include "Multiset.impl.h"
+#endif
\ No newline at end of file
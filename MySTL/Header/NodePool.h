@@ -0,0 +1,62 @@
+#ifndef _NODE_POOL_H_
+#define _NODE_POOL_H_
+
+#include "Allocator.h"
+#include "Utility.h"
+#include "Vector.h"
+
+namespace MySTL{
+	// class of node pool
+	// hands out fixed-size nodes from contiguous slabs, so nodes allocated one after
+	// another sit on adjacent cache lines, freed nodes are reused first and the
+	// slabs are only given back when the pool dies
+	template<class Node>
+	class node_pool{
+	private:
+#define POOL_SLAB_BYTES 65536
+		enum ESlabNodes{
+			SLAB_NODES = (POOL_SLAB_BYTES / sizeof(Node) < 16 ? 16 : POOL_SLAB_BYTES / sizeof(Node))
+		};
+		struct free_node{
+			free_node *next_;
+		};
+		typedef MySTL::allocator<Node> slabAllocator;
+	private:
+		vector<Node *> slabs_;
+		Node *cur_, *end_;// the unused tail of the newest slab
+		free_node *free_;
+	public:
+		node_pool() :cur_(0), end_(0), free_(0){}
+		node_pool(const node_pool&) = delete;
+		node_pool& operator = (const node_pool&) = delete;
+		~node_pool();
+
+		Node *allocate();
+		void deallocate(Node *p);
+		void swap(node_pool& other);
+		// take over the slabs and the free nodes of other, which is left empty, so
+		// that nodes allocated from other can be released into this pool
+		void merge(node_pool& other);
+	};
+
+	// node storage policies of the tree containers
+	// heap_node_storage allocates every node on its own through MySTL::allocator
+	struct heap_node_storage{
+		template<class Node>
+		class storage{
+		public:
+			Node *allocate(){ return MySTL::allocator<Node>::allocate(); }
+			void deallocate(Node *p){ MySTL::allocator<Node>::deallocate(p); }
+			void swap(storage&){}
+			void merge(storage&){}
+		};
+	};
+	// pooled_node_storage carves the nodes of each tree from slabs of its own
+	struct pooled_node_storage{
+		template<class Node>
+		class storage : public node_pool<Node>{};
+	};
+}// end of namespace MySTL
+
+#include "NodePool.impl.h"
+#endif
\ No newline at end of file
@@ -0,0 +1,166 @@
+#ifndef _PARALLEL_ALGORITHM_H_
+#define _PARALLEL_ALGORITHM_H_
+
+#include <atomic>
+#include <vector>
+
+#include "Algorithm.h"
+#include "ThreadPool.h"
+
+namespace MySTL{
+	namespace execution{
+		// execution policies of the algorithms below, the parallel ones cut the range into
+		// chunks run on the default pool, or on the pool given by on(pool)
+		struct sequenced_policy{};
+		struct parallel_policy{
+			thread_pool *pool_;
+
+			parallel_policy() :pool_(nullptr){}
+			parallel_policy on(thread_pool& pool)const{ parallel_policy p; p.pool_ = &pool; return p; }
+			thread_pool& pool()const{ return pool_ ? *pool_ : thread_pool::default_pool(); }
+		};
+		// each chunk already runs the SIMD kernels of Algorithm.h, so this is par
+		struct parallel_unsequenced_policy : parallel_policy{
+			parallel_unsequenced_policy on(thread_pool& pool)const{
+				parallel_unsequenced_policy p; p.pool_ = &pool; return p;
+			}
+		};
+
+		const sequenced_policy seq = sequenced_policy();
+		const parallel_policy par = parallel_policy();
+		const parallel_unsequenced_policy par_unseq = parallel_unsequenced_policy();
+	}
+
+	//the sequenced overloads call the plain algorithms, the parallel ones take random
+	//access iterators and give the result of the plain algorithm, save that reduce may
+	//group the items differently
+
+	//********** [min_element] ******************************
+	//********* [Algorithm Complexity: O(N)] ****************
+	template<class ForwardIterator, class Compare>
+	ForwardIterator min_element(const execution::sequenced_policy&, ForwardIterator first, ForwardIterator last, Compare comp);
+	template<class ForwardIterator>
+	ForwardIterator min_element(const execution::sequenced_policy&, ForwardIterator first, ForwardIterator last);
+	template<class RandomIterator, class Compare>
+	RandomIterator min_element(const execution::parallel_policy& policy, RandomIterator first, RandomIterator last, Compare comp);
+	template<class RandomIterator>
+	RandomIterator min_element(const execution::parallel_policy& policy, RandomIterator first, RandomIterator last);
+
+	//********** [max_element] ******************************
+	//********* [Algorithm Complexity: O(N)] ****************
+	template<class ForwardIterator, class Compare>
+	ForwardIterator max_element(const execution::sequenced_policy&, ForwardIterator first, ForwardIterator last, Compare comp);
+	template<class ForwardIterator>
+	ForwardIterator max_element(const execution::sequenced_policy&, ForwardIterator first, ForwardIterator last);
+	template<class RandomIterator, class Compare>
+	RandomIterator max_element(const execution::parallel_policy& policy, RandomIterator first, RandomIterator last, Compare comp);
+	template<class RandomIterator>
+	RandomIterator max_element(const execution::parallel_policy& policy, RandomIterator first, RandomIterator last);
+
+	//********** [reduce] ******************************
+	//********* [Algorithm Complexity: O(N)] ****************
+	//op must be associative and commutative
+	template<class InputIterator, class T, class BinaryOperation>
+	T reduce(const execution::sequenced_policy&, InputIterator first, InputIterator last, T init, BinaryOperation op);
+	template<class InputIterator, class T>
+	T reduce(const execution::sequenced_policy&, InputIterator first, InputIterator last, T init);
+	template<class InputIterator>
+	typename iterator_traits<InputIterator>::value_type
+		reduce(const execution::sequenced_policy&, InputIterator first, InputIterator last);
+	template<class RandomIterator, class T, class BinaryOperation>
+	T reduce(const execution::parallel_policy& policy, RandomIterator first, RandomIterator last, T init, BinaryOperation op);
+	template<class RandomIterator, class T>
+	T reduce(const execution::parallel_policy& policy, RandomIterator first, RandomIterator last, T init);
+	template<class RandomIterator>
+	typename iterator_traits<RandomIterator>::value_type
+		reduce(const execution::parallel_policy& policy, RandomIterator first, RandomIterator last);
+
+	//********** [transform] ******************************
+	//********* [Algorithm Complexity: O(N)] ****************
+	template<class InputIterator, class OutputIterator, class UnaryOperation>
+	OutputIterator transform(const execution::sequenced_policy&, InputIterator first, InputIterator last,
+		OutputIterator result, UnaryOperation op);
+	template<class InputIterator1, class InputIterator2, class OutputIterator, class BinaryOperation>
+	OutputIterator transform(const execution::sequenced_policy&, InputIterator1 first1, InputIterator1 last1,
+		InputIterator2 first2, OutputIterator result, BinaryOperation op);
+	template<class RandomIterator, class OutputIterator, class UnaryOperation>
+	OutputIterator transform(const execution::parallel_policy& policy, RandomIterator first, RandomIterator last,
+		OutputIterator result, UnaryOperation op);
+	template<class RandomIterator1, class RandomIterator2, class OutputIterator, class BinaryOperation>
+	OutputIterator transform(const execution::parallel_policy& policy, RandomIterator1 first1, RandomIterator1 last1,
+		RandomIterator2 first2, OutputIterator result, BinaryOperation op);
+
+	//********** [for_each] ******************************
+	//********* [Algorithm Complexity: O(N)] ****************
+	//every chunk calls a copy of fn
+	template<class InputIterator, class Function>
+	void for_each(const execution::sequenced_policy&, InputIterator first, InputIterator last, Function fn);
+	template<class RandomIterator, class Function>
+	void for_each(const execution::parallel_policy& policy, RandomIterator first, RandomIterator last, Function fn);
+
+	//********** [find_if] ******************************
+	//********* [Algorithm Complexity: O(N)] ****************
+	//a chunk gives up at the first block past an item found by another chunk
+	template<class InputIterator, class UnaryPredicate>
+	InputIterator find_if(const execution::sequenced_policy&, InputIterator first, InputIterator last, UnaryPredicate pred);
+	template<class RandomIterator, class UnaryPredicate>
+	RandomIterator find_if(const execution::parallel_policy& policy, RandomIterator first, RandomIterator last, UnaryPredicate pred);
+
+	//********** [count_if] ******************************
+	//********* [Algorithm Complexity: O(N)] ****************
+	template<class InputIterator, class UnaryPredicate>
+	typename iterator_traits<InputIterator>::difference_type
+		count_if(const execution::sequenced_policy&, InputIterator first, InputIterator last, UnaryPredicate pred);
+	template<class RandomIterator, class UnaryPredicate>
+	typename iterator_traits<RandomIterator>::difference_type
+		count_if(const execution::parallel_policy& policy, RandomIterator first, RandomIterator last, UnaryPredicate pred);
+
+	//********** [fill] ******************************
+	//********* [Algorithm Complexity: O(N)] ****************
+	template<class ForwardIterator, class T>
+	void fill(const execution::sequenced_policy&, ForwardIterator first, ForwardIterator last, const T& value);
+	template<class RandomIterator, class T>
+	void fill(const execution::parallel_policy& policy, RandomIterator first, RandomIterator last, const T& value);
+
+	//********** [copy] ******************************
+	//********* [Algorithm Complexity: O(N)] ****************
+	template<class InputIterator, class OutputIterator>
+	OutputIterator copy(const execution::sequenced_policy&, InputIterator first, InputIterator last, OutputIterator result);
+	template<class RandomIterator, class OutputIterator>
+	OutputIterator copy(const execution::parallel_policy& policy, RandomIterator first, RandomIterator last, OutputIterator result);
+
+	//********** [generate] ******************************
+	//********* [Algorithm Complexity: O(N)] ****************
+	//every chunk calls a copy of gen, which had better not keep a state
+	template<class ForwardIterator, class Generator>
+	void generate(const execution::sequenced_policy&, ForwardIterator first, ForwardIterator last, Generator gen);
+	template<class RandomIterator, class Generator>
+	void generate(const execution::parallel_policy& policy, RandomIterator first, RandomIterator last, Generator gen);
+
+	//********** [parallel_sort] ******************************
+	//********* [Algorithm Complexity: O(NlogN)] ****************
+	//quicksort whose partitions are sorted as tasks of a thread_pool, ranges below the
+	//grain size are sorted by sort; not stable
+	template<class RandomIterator, class BinaryPredicate>
+	void parallel_sort(RandomIterator first, RandomIterator last, BinaryPredicate pred, thread_pool& pool);
+	//threads counts the calling thread, 0 uses the default pool
+	template<class RandomIterator, class BinaryPredicate>
+	void parallel_sort(RandomIterator first, RandomIterator last, BinaryPredicate pred, size_t threads = 0);
+	template<class RandomIterator>
+	void parallel_sort(RandomIterator first, RandomIterator last);
+
+	//********** [sort] ******************************
+	//********* [Algorithm Complexity: O(NlogN)] ****************
+	//par is parallel_sort on the pool of the policy
+	template<class RandomIterator, class BinaryPredicate>
+	void sort(const execution::sequenced_policy&, RandomIterator first, RandomIterator last, BinaryPredicate pred);
+	template<class RandomIterator>
+	void sort(const execution::sequenced_policy&, RandomIterator first, RandomIterator last);
+	template<class RandomIterator, class BinaryPredicate>
+	void sort(const execution::parallel_policy& policy, RandomIterator first, RandomIterator last, BinaryPredicate pred);
+	template<class RandomIterator>
+	void sort(const execution::parallel_policy& policy, RandomIterator first, RandomIterator last);
+}
+
+#include "ParallelAlgorithm.impl.h"
+#endif
\ No newline at end of file
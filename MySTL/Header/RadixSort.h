@@ -0,0 +1,90 @@
+#ifndef _RADIX_SORT_H_
+#define _RADIX_SORT_H_
+
+#include "Algorithm.h"
+#include "Functional.h"
+#include "Vector.h"
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace MySTL{
+	namespace Detail{
+		// maps a key to an unsigned integer of the same order
+		template<class Key, bool = std::is_floating_point<Key>::value>
+		struct radix_key{
+			static_assert(std::is_integral<Key>::value && !std::is_same<Key, bool>::value,
+				"radix_sort keys must be integers or floating point numbers");
+			typedef typename std::make_unsigned<Key>::type type;
+			static type encode(Key key){
+				//flipping the sign bit puts the negative numbers first
+				return std::is_signed<Key>::value ?
+					static_cast<type>(static_cast<type>(key) ^ (type(1) << (sizeof(type) * 8 - 1))) : static_cast<type>(key);
+			}
+		};
+		template<class Key>
+		struct radix_key<Key, true>{
+			static_assert(sizeof(Key) == 4 || sizeof(Key) == 8, "radix_sort supports 32 and 64 bit floating point keys");
+			typedef typename std::conditional<sizeof(Key) == 4, uint32_t, uint64_t>::type type;
+			static type encode(Key key){
+				//negative numbers have all bits flipped, so a greater magnitude sorts first
+				type bits;
+				memcpy(&bits, &key, sizeof(key));
+				const type sign = type(1) << (sizeof(type) * 8 - 1);
+				return (bits & sign) ? static_cast<type>(~bits) : static_cast<type>(bits | sign);
+			}
+		};
+
+		// orders items by their encoded keys, for the ranges too short to radix sort
+		template<class KeyOfValue, class Traits>
+		struct radix_less{
+			KeyOfValue key_of_;
+			explicit radix_less(KeyOfValue key_of) :key_of_(key_of){}
+			template<class T>
+			bool operator()(const T& a, const T& b)const{
+				return Traits::encode(key_of_(a)) < Traits::encode(key_of_(b));
+			}
+		};
+
+		// orders strings known to share their first depth_ chars, the chars compare unsigned
+		struct string_less_from{
+			size_t depth_;
+			explicit string_less_from(size_t depth) :depth_(depth){}
+			template<class String>
+			bool operator()(const String& a, const String& b)const{
+				const size_t len = a.size() < b.size() ? a.size() : b.size();
+				for (size_t i = depth_; i < len; ++i){
+					if (a[i] != b[i])
+						return static_cast<unsigned char>(a[i]) < static_cast<unsigned char>(b[i]);
+				}
+				return a.size() < b.size();
+			}
+		};
+
+		// a range [lo_, hi_) of strings that share their first depth_ chars
+		struct msd_range{
+			size_t lo_, hi_, depth_;
+			explicit msd_range(size_t lo = 0, size_t hi = 0, size_t depth = 0) :lo_(lo), hi_(hi), depth_(depth){}
+		};
+	}// end of namespace Detail
+
+	//********** [radix_sort] ******************************
+	//********* [Algorithm Complexity: O(N * sizeof(key))] ****************
+	//LSD radix sort on 8-bit digits, stable; the keys are the items or key_of(item),
+	//integers or IEEE floating point numbers
+	template<class RandomIterator>
+	void radix_sort(RandomIterator first, RandomIterator last);
+	template<class RandomIterator, class KeyOfValue>
+	void radix_sort(RandomIterator first, RandomIterator last, KeyOfValue key_of);
+
+	//********** [msd_radix_sort] ******************************
+	//********* [Algorithm Complexity: O(total length of the distinguishing prefixes)] ****************
+	//MSD radix sort of strings (anything with size() and operator[] giving chars), the
+	//chars compare unsigned; short buckets are finished by sort
+	template<class RandomIterator>
+	void msd_radix_sort(RandomIterator first, RandomIterator last);
+}
+
+#include "RadixSort.impl.h"
+#endif
\ No newline at end of file
@@ -106,39 +106,39 @@ namespace MySTL{
 			return it;
 		}
 	public:
-		template <class Iterator>
-		friend bool operator == (const reverse_iterator_t<Iterator>& lhs,
-			const reverse_iterator_t<Iterator>& rhs);
-
-		template <class Iterator>
-		friend bool operator != (const reverse_iterator_t<Iterator>& lhs,
-			const reverse_iterator_t<Iterator>& rhs);
-
-		template <class Iterator>
-		friend bool operator < (const reverse_iterator_t<Iterator>& lhs,
-			const reverse_iterator_t<Iterator>& rhs);
-
-		template <class Iterator>
-		friend bool operator <= (const reverse_iterator_t<Iterator>& lhs,
-			const reverse_iterator_t<Iterator>& rhs);
-
-		template <class Iterator>
-		friend bool operator > (const reverse_iterator_t<Iterator>& lhs,
-			const reverse_iterator_t<Iterator>& rhs);
-
-		template <class Iterator>
-		friend bool operator >= (const reverse_iterator_t<Iterator>& lhs,
-			const reverse_iterator_t<Iterator>& rhs);
-
-		template <class Iterator>
-		friend reverse_iterator_t<Iterator> operator + (
-			typename reverse_iterator_t<Iterator>::difference_type n,
-			const reverse_iterator_t<Iterator>& rev_it);
-
-		template <class Iterator>
-		friend typename reverse_iterator_t<Iterator>::difference_type operator- (
-			const reverse_iterator_t<Iterator>& lhs,
-			const reverse_iterator_t<Iterator>& rhs);
+		template <class Iterator_>
+		friend bool operator == (const reverse_iterator_t<Iterator_>& lhs,
+			const reverse_iterator_t<Iterator_>& rhs);
+
+		template <class Iterator_>
+		friend bool operator != (const reverse_iterator_t<Iterator_>& lhs,
+			const reverse_iterator_t<Iterator_>& rhs);
+
+		template <class Iterator_>
+		friend bool operator < (const reverse_iterator_t<Iterator_>& lhs,
+			const reverse_iterator_t<Iterator_>& rhs);
+
+		template <class Iterator_>
+		friend bool operator <= (const reverse_iterator_t<Iterator_>& lhs,
+			const reverse_iterator_t<Iterator_>& rhs);
+
+		template <class Iterator_>
+		friend bool operator > (const reverse_iterator_t<Iterator_>& lhs,
+			const reverse_iterator_t<Iterator_>& rhs);
+
+		template <class Iterator_>
+		friend bool operator >= (const reverse_iterator_t<Iterator_>& lhs,
+			const reverse_iterator_t<Iterator_>& rhs);
+
+		template <class Iterator_>
+		friend reverse_iterator_t<Iterator_> operator + (
+			typename reverse_iterator_t<Iterator_>::difference_type n,
+			const reverse_iterator_t<Iterator_>& rev_it);
+
+		template <class Iterator_>
+		friend typename reverse_iterator_t<Iterator_>::difference_type operator- (
+			const reverse_iterator_t<Iterator_>& lhs,
+			const reverse_iterator_t<Iterator_>& rhs);
 	};// end of reverse_iterator_t
 
 	template<class Iterator>
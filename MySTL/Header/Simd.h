@@ -0,0 +1,52 @@
+#ifndef _SIMD_H_
+#define _SIMD_H_
+
+#include <cstddef>
+#include <cstdint>
+
+// x86 builds get SSE2 and, when the cpu has it, AVX2 kernels; define MYSTL_NO_SIMD
+// to keep the plain loops
+#if !defined(MYSTL_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define MYSTL_SIMD_X86 1
+#else
+#define MYSTL_SIMD_X86 0
+#endif
+
+namespace MySTL{
+	enum simd_level{ SIMD_SCALAR, SIMD_SSE2, SIMD_AVX2 };
+	// the instruction set the kernels use on this machine, checked once
+	simd_level current_simd_level();
+
+	namespace Detail{
+		// kernels over n unsigned integers of width 1, 2, 4 or 8 bytes, val is truncated to
+		// the width; used by find, count, mismatch, equal and search of Algorithm.h
+		// index of the first item equal to val, n if there is none
+		size_t simd_find(const void *first, size_t n, uint64_t val, size_t width);
+		// number of items equal to val
+		size_t simd_count(const void *first, size_t n, uint64_t val, size_t width);
+		// number of equal leading bytes of a and b
+		size_t simd_mismatch(const void *a, const void *b, size_t bytes);
+
+		// kernels over n numbers for min_element, max_element, accumulate and reduce, the
+		// sums are taken in any order
+		int32_t simd_sum(const int32_t *first, size_t n);
+		int64_t simd_sum(const int64_t *first, size_t n);
+		uint32_t simd_sum(const uint32_t *first, size_t n);
+		uint64_t simd_sum(const uint64_t *first, size_t n);
+		float simd_sum(const float *first, size_t n);
+		double simd_sum(const double *first, size_t n);
+		// index of the first least (or greatest) item of a non empty range, SIMD_NO_INDEX
+		// if there is a NaN, whose order the kernels leave to the caller
+		const size_t SIMD_NO_INDEX = static_cast<size_t>(-1);
+		size_t simd_min_index(const int32_t *first, size_t n);
+		size_t simd_min_index(const int64_t *first, size_t n);
+		size_t simd_min_index(const float *first, size_t n);
+		size_t simd_min_index(const double *first, size_t n);
+		size_t simd_max_index(const int32_t *first, size_t n);
+		size_t simd_max_index(const int64_t *first, size_t n);
+		size_t simd_max_index(const float *first, size_t n);
+		size_t simd_max_index(const double *first, size_t n);
+	}
+}
+
+#endif
\ No newline at end of file
@@ -24,13 +24,13 @@ namespace MySTL{
 		void pop(){ container_.pop_back(); }
 		void swap(stack& x) { MySTL::swap(container_, x.container_); }
 	public:
-		template <class T, class Container>
-		friend bool operator== (const stack<T, Container>& lhs, const stack<T, Container>& rhs);
-		template <class T, class Container>
-		friend bool operator!= (const stack<T, Container>& lhs, const stack<T, Container>& rhs);
+		template <class T_, class Container_>
+		friend bool operator== (const stack<T_, Container_>& lhs, const stack<T_, Container_>& rhs);
+		template <class T_, class Container_>
+		friend bool operator!= (const stack<T_, Container_>& lhs, const stack<T_, Container_>& rhs);
 
-		template <class T, class Container>
-		friend void swap(stack<T, Container>& x, stack<T, Container>& rhs);
+		template <class T_, class Container_>
+		friend void swap(stack<T_, Container_>& x, stack<T_, Container_>& rhs);
 	}; // end of stack
 
 	template <class T, class Container>
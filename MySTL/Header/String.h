@@ -7,6 +7,7 @@
 #include "Utility.h"
 
 #include <cstring>
+#include <iostream>
 #include <type_traits>
 
 namespace MySTL{
@@ -0,0 +1,76 @@
+#ifndef _THREAD_POOL_H_
+#define _THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace MySTL{
+	// class of thread_pool
+	// every worker owns a queue, it runs its own tasks newest first and steals the
+	// oldest task of another queue when its own is empty; tasks submitted from a
+	// thread outside the pool go to an extra shared queue
+	class thread_pool{
+	public:
+		typedef std::function<void()> task_type;
+	private:
+		struct task_queue{
+			std::mutex lock_;
+			std::deque<task_type> tasks_;
+		};
+	private:
+		task_queue *queues_;// size_ + 1 queues, the last one is the shared queue
+		std::thread *workers_;
+		size_t size_;
+		std::atomic<size_t> queued_;// tasks submitted but not taken yet
+		std::mutex sleep_lock_;
+		std::condition_variable wakeup_;
+		bool stop_;
+	public:
+		// 0 threads is allowed, the tasks then run in task_group::wait
+		explicit thread_pool(size_t threads = std::thread::hardware_concurrency());
+		thread_pool(const thread_pool&) = delete;
+		thread_pool& operator = (const thread_pool&) = delete;
+		~thread_pool();
+
+		size_t size()const{ return size_; }
+		void submit(task_type task);
+		// run one queued task on the calling thread, false if there was none
+		bool run_one();
+
+		// the pool shared by the parallel algorithms, one worker per core besides the caller
+		static thread_pool& default_pool();
+	private:
+		size_t self_index()const;
+		bool pop(size_t index, task_type& task);
+		bool steal(size_t index, task_type& task);
+		bool try_run(size_t index);
+		void work(size_t index);
+	};
+
+	// class of task_group
+	// forks tasks onto a pool and joins them, the waiting thread runs queued tasks
+	// meanwhile so a task may wait on a group of its own
+	class task_group{
+	private:
+		thread_pool& pool_;
+		std::atomic<size_t> pending_;
+	public:
+		explicit task_group(thread_pool& pool) :pool_(pool), pending_(0){}
+		task_group(const task_group&) = delete;
+		task_group& operator = (const task_group&) = delete;
+		~task_group(){ wait(); }
+
+		// func must not throw, an exception leaving it calls std::terminate
+		template<class Function>
+		void run(Function func);
+		void wait();
+	};
+}
+
+#include "ThreadPool.impl.h"
+#endif
\ No newline at end of file
@@ -18,7 +18,7 @@ namespace MySTL{
 
 	template<class InputIterator, class ForwardIterator>
 	ForwardIterator uninitialized_copy(InputIterator first, InputIterator last, ForwardIterator result){
-		typedef typename _type_traits<iterator_traits<InputIterator>::value_type>::is_POD_type isPODType;
+		typedef typename _type_traits<typename iterator_traits<InputIterator>::value_type>::is_POD_type isPODType;
 		return _uninitialized_copy_aux(first, last, result, isPODType());
 	}
 
@@ -57,7 +57,7 @@ namespace MySTL{
 	template<class ForwardIterator, class T>
 	void _uninitialized_fill_aux(ForwardIterator first, ForwardIterator last,
 		const T& value, _true_type){
-		fill(first, last, value);
+		MySTL::fill(first, last, value);
 	}
 
 	template<class ForwardIterator, class T>
@@ -87,7 +87,7 @@ namespace MySTL{
 	template<class ForwardIterator, class Size, class T>
 	ForwardIterator _uninitialized_fill_n_aux(ForwardIterator first,
 		Size n, const T& x, _true_type){
-		return fill_n(first, n, x);
+		return MySTL::fill_n(first, n, x);
 	}
 
 	template<class ForwardIterator, class Size, class T>
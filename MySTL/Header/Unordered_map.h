@@ -0,0 +1,115 @@
+#ifndef _UNORDERED_MAP_H_
+#define _UNORDERED_MAP_H_
+
+#include "Allocator.h"
+#include "Functional.h"
+#include "Unordered_set.h"
+#include "Utility.h"
+
+namespace MySTL{
+	namespace Detail{
+		// hash the key part of a (key, value) pair, other types are handed to Hash
+		// directly so that a transparent Hash gives heterogeneous lookup
+		template<class Key, class T, class Hash>
+		struct umap_hasher{
+			size_t operator()(const MySTL::pair<Key, T>& val)const{ return Hash()(val.first); }
+			template<class K>
+			size_t operator()(const K& key)const{ return Hash()(key); }
+		};
+
+		// compare (key, value) pairs by key only
+		template<class Key, class T, class KeyEqual>
+		struct umap_key_equal{
+			bool operator()(const MySTL::pair<Key, T>& lhs, const MySTL::pair<Key, T>& rhs)const{
+				return KeyEqual()(lhs.first, rhs.first);
+			}
+			template<class K>
+			bool operator()(const K& key, const MySTL::pair<Key, T>& val)const{
+				return KeyEqual()(key, val.first);
+			}
+		};
+	}// end of namespace Detail
+
+	// class of Unordered_map
+	// the buckets, rehash policy and iterators are those of Unordered_set, which
+	// stores the (key, value) pairs and only looks at the key
+	template<class Key, class T, class Hash = std::hash<Key>,
+	class KeyEqual = MySTL::equal_to<Key>, class Allocator = MySTL::allocator<MySTL::pair<Key, T>>,
+	class BucketPolicy = MySTL::prime_bucket_policy>
+	class Unordered_map{
+	public:
+		typedef Key key_type;
+		typedef T mapped_type;
+		typedef MySTL::pair<Key, T> value_type;// the key must not be modified through an iterator
+		typedef size_t size_type;
+		typedef Hash haser;
+		typedef KeyEqual key_equal;
+		typedef Allocator allocator_type;
+		typedef BucketPolicy bucket_policy;
+		typedef value_type& reference;
+		typedef const value_type& const_reference;
+
+	private:
+		typedef Unordered_set<value_type, Detail::umap_hasher<Key, T, Hash>,
+			Detail::umap_key_equal<Key, T, KeyEqual>, Allocator, BucketPolicy> table_type;
+
+	public:
+		typedef typename table_type::iterator iterator;
+		typedef typename table_type::local_iterator local_iterator;
+
+	private:
+		table_type table_;
+
+	public:
+		explicit Unordered_map(size_type bucket_count) :table_(bucket_count){}
+		template<class InputIterator>
+		Unordered_map(InputIterator first, InputIterator last) : table_(first, last){}
+
+		size_type size()const{ return table_.size(); }
+		bool empty()const{ return table_.empty(); }
+		size_type bucket_count()const{ return table_.bucket_count(); }
+		size_type bucket_size(size_type i)const{ return table_.bucket_size(i); }
+		size_type bucket(const key_type& key)const{ return table_.bucket(key); }
+		float load_factor()const{ return table_.load_factor(); }
+		float max_load_factor()const{ return table_.max_load_factor(); }
+		void max_load_factor(float z){ table_.max_load_factor(z); }
+		void rehash(size_type n){ table_.rehash(n); }
+		bool incremental_rehash()const{ return table_.incremental_rehash(); }
+		void incremental_rehash(bool enable){ table_.incremental_rehash(enable); }
+
+		iterator begin(){ return table_.begin(); }
+		iterator end(){ return table_.end(); }
+		local_iterator begin(size_type i){ return table_.begin(i); }
+		local_iterator end(size_type i){ return table_.end(i); }
+
+		iterator find(const key_type& key){ return table_.find(key); }
+		template<class K>
+		iterator find(const K& key){ return table_.find(key); }// heterogeneous lookup
+		size_type count(const key_type& key){ return find(key) == end() ? 0 : 1; }
+		template<class K>
+		size_type count(const K& key){ return find(key) == end() ? 0 : 1; }
+
+		mapped_type& operator[](const key_type& key);
+		MySTL::pair<iterator, bool> insert(const value_type& val);
+		template<class InputIterator>
+		void insert(InputIterator first, InputIterator last);
+		template<class... Args>
+		MySTL::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args);
+		template<class M>
+		MySTL::pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj);
+		iterator erase(iterator position){ return table_.erase(position); }
+		size_type erase(const key_type& key);
+
+		haser hash_function()const{ return haser(); }
+		key_equal key_eq()const{ return key_equal(); }
+		allocator_type get_allocator()const{ return allocator_type(); }
+
+	public:
+		template<class Key_, class T_, class Hash_, class KeyEqual_, class Allocator_, class BucketPolicy_>
+		friend void swap(Unordered_map<Key_, T_, Hash_, KeyEqual_, Allocator_, BucketPolicy_>& lhs,
+			Unordered_map<Key_, T_, Hash_, KeyEqual_, Allocator_, BucketPolicy_>& rhs);
+	};
+}// end of namespace MySTL
+
+#include "Unordered_map.impl.h"
+#endif
\ No newline at end of file
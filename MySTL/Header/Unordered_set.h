@@ -5,49 +5,106 @@
 #include "Algorithm.h"
 #include "Functional.h"
 #include "Iterator.h"
-#include "List.h"
+#include "Utility.h"
 #include "Vector.h"
 
+#include <functional>
+
 namespace MySTL{
-	template<class Key, class Hash, class KeyEqual, class Allocator>
+	// bucket policies of Unordered_set
+	// bucket_count(n) gives the table size to use for at least n buckets and
+	// index(hash, count) maps a hash value into [0, count)
+	// id tells the policies apart in persisted tables such as snapshot files
+
+	// prime sized table, index = hash % count
+	struct prime_bucket_policy{
+		enum{ id = 1 };
+		static size_t bucket_count(size_t n);
+		static size_t index(size_t hash, size_t count){ return hash % count; }
+	};
+	// prime sized table, the mixed hash is mapped into [0, count) with a
+	// multiply and a shift (Lemire's fast range reduction) instead of a division
+	struct fastrange_bucket_policy{
+		enum{ id = 2 };
+		static size_t bucket_count(size_t n){ return prime_bucket_policy::bucket_count(n); }
+		static size_t index(size_t hash, size_t count);
+	};
+	// power-of-two sized table, index = mixed hash & (count - 1)
+	// the hash is mixed first since std::hash is the identity for integers
+	struct power2_bucket_policy{
+		enum{ id = 3 };
+		static size_t bucket_count(size_t n);
+		static size_t index(size_t hash, size_t count);
+	};
+
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
 	class Unordered_set;
 	namespace Detail{
+		// node of a bucket, every bucket is a null terminated singly linked chain
+		// so that an empty bucket is a single null pointer
+		template<class Key>
+		struct ust_node{
+			Key value;
+			ust_node *next;
+			ust_node(const Key& v, ust_node *n) :value(v), next(n){}
+		};
+
+		// iterator over the chain of one bucket, the end of every chain is null
+		template<class Key>
+		struct ust_local_iterator : public iterator<forward_iterator_tag, Key>{
+		public:
+			typedef ust_node<Key>* nodePtr;
+			nodePtr p;
+		public:
+			explicit ust_local_iterator(nodePtr ptr = nullptr) :p(ptr){}
+			ust_local_iterator& operator ++(){ p = p->next; return *this; }
+			ust_local_iterator operator ++(int){ auto res = *this; p = p->next; return res; }
+			Key& operator*() { return p->value; }
+			Key* operator->() { return &(operator*()); }
+
+			friend bool operator ==(const ust_local_iterator& lhs, const ust_local_iterator& rhs){ return lhs.p == rhs.p; }
+			friend bool operator !=(const ust_local_iterator& lhs, const ust_local_iterator& rhs){ return lhs.p != rhs.p; }
+		};
+
 		template<class Key, class ListIterator, class Hash = std::hash<Key>,
-		class KeyEqual = MySTL::equal_to<Key>, class Allocator = MySTL::allocator<Key>>
+		class KeyEqual = MySTL::equal_to<Key>, class Allocator = MySTL::allocator<Key>,
+		class BucketPolicy = MySTL::prime_bucket_policy>
 		class ust_iterator : public iterator<forward_iterator_tag, Key>{
 
 		private:
-			template<class Key, class Hash, class KeyEqual, class Allocator>
-			friend class Unordered_set;
+			template<class Key_, class Hash_, class KeyEqual_, class Allocator_, class BucketPolicy_>
+			friend class ::MySTL::Unordered_set;
 
 		private:
-			typedef Unordered_set<Key, Hash, KeyEqual, Allocator>* cntrPtr;
+			typedef Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>* cntrPtr;
 			size_t bucket_index_;
 			ListIterator iterator_;
 			cntrPtr container_;
 
 		public:
+			ust_iterator() :bucket_index_(0), container_(0){}
 			ust_iterator(size_t index, ListIterator it, cntrPtr ptr);
 			ust_iterator& operator ++();
 			ust_iterator operator ++(int);
 			Key& operator*() { return *iterator_; }
-			Key* operator->() { return &(operator8()); }
+			Key* operator->() { return &(operator*()); }
 
 		private:
-			template<class Key, class ListIterator, class Hash, class KeyEqual, class Allocator>
-			friend bool operator ==(const ust_iterator<Key, ListIterator, Hash, KeyEqual, Allocator>& lhs,
-				const ust_iterator<Key, ListIterator, Hash, KeyEqual, Allocator>& rhs);
-			template<class Key, class ListIterator, class Hash, class KeyEqual, class Allocator>
-			friend bool operator !=(const ust_iterator<Key, ListIterator, Hash, KeyEqual, Allocator>& lhs,
-				const ust_iterator<Key, ListIterator, Hash, KeyEqual, Allocator>& rhs);
+			template<class Key_, class ListIterator_, class Hash_, class KeyEqual_, class Allocator_, class BucketPolicy_>
+			friend bool operator ==(const ust_iterator<Key_, ListIterator_, Hash_, KeyEqual_, Allocator_, BucketPolicy_>& lhs,
+				const ust_iterator<Key_, ListIterator_, Hash_, KeyEqual_, Allocator_, BucketPolicy_>& rhs);
+			template<class Key_, class ListIterator_, class Hash_, class KeyEqual_, class Allocator_, class BucketPolicy_>
+			friend bool operator !=(const ust_iterator<Key_, ListIterator_, Hash_, KeyEqual_, Allocator_, BucketPolicy_>& lhs,
+				const ust_iterator<Key_, ListIterator_, Hash_, KeyEqual_, Allocator_, BucketPolicy_>& rhs);
 		};
 	}// end of namespace Detail
 
 	template<class Key, class Hash = std::hash<Key>,
-	class KeyEqual = MySTL::equal_to<Key>, class Allocator = MySTL::allocator<Key>>
+	class KeyEqual = MySTL::equal_to<Key>, class Allocator = MySTL::allocator<Key>,
+	class BucketPolicy = MySTL::prime_bucket_policy>
 	class Unordered_set{
 	private:
-		template<class Key, class ListIterator, class Hash, class KeyEqual, class Allocator>
+		template<class Key_, class ListIterator_, class Hash_, class KeyEqual_, class Allocator_, class BucketPolicy_>
 		friend class Detail::ust_iterator;
 
 	public:
@@ -59,41 +116,79 @@ namespace MySTL{
 		typedef Allocator allocator_type;
 		typedef value_type& reference;
 		typedef const value_type& const_reference;
-		typedef typename MySTL::list<key_type>::iterator local_iterator;
-		typedef Detail::ust_iterator<Key, typename MySTL::list<key_type>::iterator, Hash, KeyEqual, Allocator> iterator;
+		typedef Detail::ust_local_iterator<key_type> local_iterator;
+		typedef BucketPolicy bucket_policy;
+		typedef Detail::ust_iterator<Key, local_iterator, Hash, KeyEqual, Allocator, BucketPolicy> iterator;
 
 	private:
-		MySTL::vector<MySTL::list<key_type>> buckets_;
+		typedef Detail::ust_node<key_type> node_type;
+		typedef allocator<node_type> nodeAllocator;
+		// bucket heads, growing the table is one allocation of null pointers
+		MySTL::vector<node_type*> buckets_;
 		size_type size_;
 		float max_load_factor_;
-#define PRIME_LIST_SIZE 28
-		static size_t prime_list_[PRIME_LIST_SIZE];
+		// incremental rehash: while old_buckets_ is not empty, the buckets in
+		// [migrate_index_, old_buckets_.size()) still hold elements that have not
+		// been moved into buckets_ yet, an iterator reaches them as the buckets
+		// numbered from bucket_count() on; as every lookup, insert or erase moves
+		// some of them, an iterator kept across such a call may skip or repeat
+		// elements until the migration ends, begin() finishes it first
+		bool incremental_;
+		MySTL::vector<node_type*> old_buckets_;
+		size_type migrate_index_;
+#define REHASH_STEP 4 // number of old buckets migrated by each operation
+#define PREFETCH_BATCH 16 // number of elements hashed and prefetched ahead by range insert and batched lookups
 	public:
 		explicit Unordered_set(size_t bucket_count);
 		template<class InputIterator>
 		Unordered_set(InputIterator first, InputIterator last);
 		Unordered_set(const Unordered_set& ust);
 		Unordered_set& operator= (const Unordered_set& ust);
+		~Unordered_set();
 
 		size_type size()const;
 		bool empty()const;
 		size_type bucket_count()const;
+		// while an incremental rehash is pending, the elements that are still in the
+		// old table are not counted, call begin(i) first to finish the migration
 		size_type bucket_size(size_type i)const;
 		size_type bucket(const key_type& key)const;
+		template<class K>
+		size_type bucket(const K& key)const;
 		float load_factor()const;
 		float max_load_factor()const;
 		void max_load_factor(float z);
 		void rehash(size_type n);
+		void reserve(size_type n);
+		bool incremental_rehash()const;
+		void incremental_rehash(bool enable);
 
 		iterator begin();
 		iterator end();
-		local_iterator begin(size_type i);
+		local_iterator begin(size_type i);// finishes a pending incremental rehash
 		local_iterator end(size_type i);
 
 		iterator find(const key_type& key);
+		template<class K>
+		iterator find(const K& key);// heterogeneous lookup, Hash and KeyEqual must accept K
 		size_type count(const key_type& key);
+		// look up n keys at once: a group of keys is hashed and all the target buckets
+		// are prefetched before any of them is searched, so the cache misses overlap
+		// out[i] is the element equal to keys[i] or end()
+		template<class K>
+		void find_batch(const K *keys, size_type n, iterator *out);
+		// out[i] tells whether keys[i] is present
+		template<class K>
+		void contains_batch(const K *keys, size_type n, bool *out);
 
 		MySTL::pair<iterator, bool> insert(const value_type& val);
+		// return the element equal to key, or insert make() if there is none
+		// key is hashed once, make() is only called for a new element and
+		// must return a value equal to key
+		template<class K, class Make>
+		MySTL::pair<iterator, bool> find_or_insert(const K& key, Make make);
+		// forward ranges are pre-hashed in batches with the target buckets prefetched,
+		// and the table is grown at most once for the whole range
 		template<class InputIterator>
 		void insert(InputIterator first, InputIterator last);
 		iterator erase(iterator position);
@@ -104,14 +199,34 @@ namespace MySTL{
 		allocator_type get_allocator()const;
 
 	private:
-		size_type next_prime(size_type n)const;
-		size_type bucket_index(const key_type& key)const;
-		bool has_key(const key_type& key);
+		size_type next_bucket_count(size_type n)const;
+		node_type *new_node(const value_type& val, node_type *next);
+		void delete_node(node_type *p);
+		void destroy_table(MySTL::vector<node_type*>& table);
+		void copy_table(MySTL::vector<node_type*>& to, const MySTL::vector<node_type*>& from);
+		node_type *&head(size_type i);// bucket i of buckets_, or of old_buckets_ from bucket_count() on
+		template<class K>
+		size_type bucket_index(const K& key)const;
+		bool migrating()const;
+		void migrate_bucket(size_type i);
+		template<class K>
+		void migrate_key(const K& key);
+		void migrate_hash(size_t hash);
+		void migrate_step();
+		void migrate_all();
+		// hash m <= PREFETCH_BATCH keys, prefetch their buckets and search them,
+		// pos[i] is the node equal to keys[i] or the end of bucket index[i]
+		template<class K>
+		void probe_group(const K *keys, size_type m, size_type *index, local_iterator *pos);
+		template<class InputIterator>
+		void insert_aux(InputIterator first, InputIterator last, input_iterator_tag);
+		template<class ForwardIterator>
+		void insert_aux(ForwardIterator first, ForwardIterator last, forward_iterator_tag);
 
 	public:
-		template<class Key, class Hash, class KeyEqual, class Allocator>
-		friend void swap(Unordered_set<Key, Hash, KeyEqual, Allocator>& lhs,
-			Unordered_set<Key, Hash, KeyEqual, Allocator>& rhs);
+		template<class Key_, class Hash_, class KeyEqual_, class Allocator_, class BucketPolicy_>
+		friend void swap(Unordered_set<Key_, Hash_, KeyEqual_, Allocator_, BucketPolicy_>& lhs,
+			Unordered_set<Key_, Hash_, KeyEqual_, Allocator_, BucketPolicy_>& rhs);
 	};
 }// end of namespace MySTL
 
@@ -1,13 +1,31 @@
 #ifndef _UTILITY_H_
 #define _UTILITY_H_
 
+#include <utility>
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <xmmintrin.h>
+#endif
+
 namespace MySTL{
+	//************ [prefetch] ***************
+	// hint the cpu to start loading the cache line of addr, a no-op where unsupported
+	inline void prefetch(const void *addr){
+#if defined(__GNUC__)
+		__builtin_prefetch(addr);
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+		_mm_prefetch(static_cast<const char *>(addr), _MM_HINT_T0);
+#else
+		(void)addr;
+#endif
+	}
+
 	//************ [swap] ***************
 	template<class T>
 	void swap(T& a, T& b){
-		T temp = a;
-		a = b;
-		b = temp;
+		T temp = std::move(a);
+		a = std::move(b);
+		b = std::move(temp);
 	}
 
 	//*********** [pair] ****************
@@ -27,20 +45,20 @@ namespace MySTL{
 		pair& operator= (const pair& pr);
 		void swap(pair& pr);
 	public:
-		template <class T1, class T2>
-		friend bool operator== (const pair<T1, T2>& lhs, const pair<T1, T2>& rhs);
-		template <class T1, class T2>
-		friend bool operator!= (const pair<T1, T2>& lhs, const pair<T1, T2>& rhs);
-		template <class T1, class T2>
-		friend bool operator<  (const pair<T1, T2>& lhs, const pair<T1, T2>& rhs);
-		template <class T1, class T2>
-		friend bool operator<= (const pair<T1, T2>& lhs, const pair<T1, T2>& rhs);
-		template <class T1, class T2>
-		friend bool operator>  (const pair<T1, T2>& lhs, const pair<T1, T2>& rhs);
-		template <class T1, class T2>
-		friend bool operator>= (const pair<T1, T2>& lhs, const pair<T1, T2>& rhs);
-		template <class T1, class T2>
-		friend void swap(pair<T1, T2>& x, pair<T1, T2>& y);
+		template <class T1_, class T2_>
+		friend bool operator== (const pair<T1_, T2_>& lhs, const pair<T1_, T2_>& rhs);
+		template <class T1_, class T2_>
+		friend bool operator!= (const pair<T1_, T2_>& lhs, const pair<T1_, T2_>& rhs);
+		template <class T1_, class T2_>
+		friend bool operator<  (const pair<T1_, T2_>& lhs, const pair<T1_, T2_>& rhs);
+		template <class T1_, class T2_>
+		friend bool operator<= (const pair<T1_, T2_>& lhs, const pair<T1_, T2_>& rhs);
+		template <class T1_, class T2_>
+		friend bool operator>  (const pair<T1_, T2_>& lhs, const pair<T1_, T2_>& rhs);
+		template <class T1_, class T2_>
+		friend bool operator>= (const pair<T1_, T2_>& lhs, const pair<T1_, T2_>& rhs);
+		template <class T1_, class T2_>
+		friend void swap(pair<T1_, T2_>& x, pair<T1_, T2_>& y);
 
 	};
 
@@ -91,7 +91,7 @@ namespace MySTL{
 		iterator erase(iterator first, iterator last);
 
 		// Ŀռ
-		Alloc get_allocate(){ return dataAllocator; }
+		Alloc get_allocate(){ return dataAllocator(); }
 	private:
 		void destroyAndDeallocateAll();
 		void allocateAndFillN(const size_type n, const value_type& value);
@@ -111,10 +111,10 @@ namespace MySTL{
 		void reallocateAndFillN(iterator position, const size_type& n, const value_type& val);
 		size_type getNewCapacity(size_type len)const;
 	public:
-		template<class T, class Alloc>
-		friend bool operator == (const vector<T, Alloc>& v1, const vector<T, Alloc>& v2);
-		template<class T, class Alloc>
-		friend bool operator != (const vector<T, Alloc>& v1, const vector<T, Alloc>& v2);
+		template<class T_, class Alloc_>
+		friend bool operator == (const vector<T_, Alloc_>& v1, const vector<T_, Alloc_>& v2);
+		template<class T_, class Alloc_>
+		friend bool operator != (const vector<T_, Alloc_>& v1, const vector<T_, Alloc_>& v2);
 	};// end of class vector
 }
 
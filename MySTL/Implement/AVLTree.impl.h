@@ -3,48 +3,21 @@
 
 namespace MySTL{
 	namespace Detail{
-		template<class T>
-		avl_iter<T>::avl_iter(const T *ptr, cntrPtr container)
-			:ptr_(ptr), container_(container){
-			if (!ptr_)
-				return;
-			auto temp = container_->root_;
-			while (temp && temp != ptr_ && temp->data_ != ptr_->data_){
-				parent_.push(temp);
-				if (temp->data_ < ptr_->data_){
-					//temp˵temoָĸڵ㲻Ҫٴη
-					visited_.insert(temp);
-					temp = temp->right_;
-				}
-				else if (temp->data_ > ptr_->data_){
-					temp = temp->left_;
-				}
-			}
-		}
 		template<class T>
 		avl_iter<T>& avl_iter<T>::operator ++(){
-			visited_.insert(ptr_);//node
-			if (ptr_->right_){//node
-				//rvisited_.insert(ptr_);
-				parent_.push(ptr_);
+			if (ptr_->right_){//the leftmost node of the right subtree
 				ptr_ = ptr_->right_;
-				while (ptr_ && ptr_->left_){
-					parent_.push(ptr_);
+				while (ptr_->left_)
 					ptr_ = ptr_->left_;
+			}
+			else{//climb until coming up from a left child, 0 past the last node
+				auto child = ptr_;
+				ptr_ = ptr_->parent_;
+				while (ptr_ && ptr_->right_ == child){
+					child = ptr_;
+					ptr_ = ptr_->parent_;
 				}
 			}
-			else{//nodeֻ򸸽ڵ·ƶ
-				ptr_ = 0;
-				while (!parent_.empty()){
-					ptr_ = parent_.top();
-					parent_.pop();
-					if (visited_.count(ptr_) == 0){//ڵδ,ʱptr_ָ˽ڵ
-						visited_.insert(ptr_);
-						break;
-					}
-					ptr_ = 0;//Ϊڱ
-				}//end of while
-			}//end of if
 			return *this;
 		}
 		template<class T>
@@ -63,175 +36,389 @@ namespace MySTL{
 		}
 	}//end of Detail namespace
 
-	template<class T>
-	typename avl_tree<T>::node *avl_tree<T>::singleLeftLeftRotate(node *k2){
+	template<class T, class Compare, class NodeStorage>
+	typename avl_tree<T, Compare, NodeStorage>::node *avl_tree<T, Compare, NodeStorage>::singleLeftLeftRotate(node *k2){
 		auto k1 = k2->left_;
 		k2->left_ = k1->right_;
+		if (k2->left_ != 0)
+			k2->left_->parent_ = k2;
 		k1->right_ = k2;
+		k1->parent_ = k2->parent_;
+		k2->parent_ = k1;
 		k2->height_ = max(getHeight(k2->left_), getHeight(k2->right_)) + 1;
 		k1->height_ = max(getHeight(k1->left_), k2->height_) + 1;
+		k1->weight_ = k2->weight_;
+		k2->weight_ = getWeight(k2->left_) + getWeight(k2->right_) + 1;
 		return k1;
 	}
-	template<class T>
-	typename avl_tree<T>::node *avl_tree<T>::doubleLeftRightRotate(node * k3){
+	template<class T, class Compare, class NodeStorage>
+	typename avl_tree<T, Compare, NodeStorage>::node *avl_tree<T, Compare, NodeStorage>::doubleLeftRightRotate(node * k3){
 		k3->left_ = singleRightRightRotate(k3->left_);
 		return singleLeftLeftRotate(k3);
 	}
-	template<class T>
-	typename avl_tree<T>::node *avl_tree<T>::doubleRightLeftRotate(node * k3){
+	template<class T, class Compare, class NodeStorage>
+	typename avl_tree<T, Compare, NodeStorage>::node *avl_tree<T, Compare, NodeStorage>::doubleRightLeftRotate(node * k3){
 		k3->right_ = singleLeftLeftRotate(k3->right_);
 		return singleRightRightRotate(k3);
 	}
-	template<class T>
-	typename avl_tree<T>::node *avl_tree<T>::singleRightRightRotate(node * k2){
+	template<class T, class Compare, class NodeStorage>
+	typename avl_tree<T, Compare, NodeStorage>::node *avl_tree<T, Compare, NodeStorage>::singleRightRightRotate(node * k2){
 		auto k1 = k2->right_;
 		k2->right_ = k1->left_;
+		if (k2->right_ != 0)
+			k2->right_->parent_ = k2;
 		k1->left_ = k2;
+		k1->parent_ = k2->parent_;
+		k2->parent_ = k1;
 		k2->height_ = max(getHeight(k2->left_), getHeight(k2->right_)) + 1;
 		k1->height_ = max(k2->height_, getHeight(k1->right_)) + 1;
+		k1->weight_ = k2->weight_;
+		k2->weight_ = getWeight(k2->left_) + getWeight(k2->right_) + 1;
 		return k1;
 	}
-	template<class T>
-	void avl_tree<T>::destroyAndDeallocateAllNodes(node *p){
+	template<class T, class Compare, class NodeStorage>
+	void avl_tree<T, Compare, NodeStorage>::destroyAndDeallocateAllNodes(node *p){
 		if (p != 0){
 			destroyAndDeallocateAllNodes(p->left_);
 			destroyAndDeallocateAllNodes(p->right_);
 			dataAllocator::destroy(p);
-			dataAllocator::deallocate(p);
+			storage_.deallocate(p);
 		}
 	}
-	template<class T>
-	avl_tree<T>::~avl_tree(){
+	template<class T, class Compare, class NodeStorage>
+	avl_tree<T, Compare, NodeStorage>::~avl_tree(){
 		destroyAndDeallocateAllNodes(root_);
 	}
-	template<class T>
-	void avl_tree<T>::erase_elem(const T& val, node *&p){
+	template<class T, class Compare, class NodeStorage>
+	template<class K>
+	bool avl_tree<T, Compare, NodeStorage>::erase_elem(const K& key, node *&p){
 		if (p == 0)
-			return;
-		if (p->data_ != val){
-			if (val < p->data_)
-				return erase_elem(val, p->left_);
-			else
-				return erase_elem(val, p->right_);
+			return false;
+		bool erased = true;
+		if (Compare()(key, p->data_)){
+			erased = erase_elem(key, p->left_);
+		}
+		else if (Compare()(p->data_, key)){
+			erased = erase_elem(key, p->right_);
 		}
 		else{ // found
+			auto temp = p;
 			if (p->left_ != 0 && p->right_ != 0){// has two children
-				size_t choose = size_ % 2;
-				//ѡɾңʹɾƽ
-				auto pos = (choose == 0 ?
-					const_cast<node *>(find_min_aux(p->right_).ptr_) : const_cast<node *>(find_max_aux(p->left_).ptr_));
-				p->data_ = pos->data_;
-				return (choose == 0 ? erase_elem(pos->data_, p->right_) : erase_elem(pos->data_, p->left_));
+				//unlink the successor node and splice it into the place of p, no data is
+				//copied so an equal value or an iterator to another node stays untouched
+				node *min;
+				auto right = remove_min(p->right_, min);
+				min->left_ = p->left_;
+				min->right_ = right;
+				p = min;
 			}
 			else{ //has one or no child
-				auto temp = p;
 				if (p->left_ == 0)
 					p = p->right_;
 				else
 					p = p->left_;
-				dataAllocator::destroy(temp);
-				dataAllocator::deallocate(temp);
-				--size_;
-			}
-		}
-		if (p != 0){//pĽڵ߶Ϣתάƽ
-			p->height_ = max(getHeight(p->left_), getHeight(p->right_)) + 1;
-			if (getHeight(p->left_) - getHeight(p->right_) == 2){
-				if (p->left_->right_ == 0)
-					singleLeftLeftRotate(p);
-				else
-					doubleLeftRightRotate(p);
-			}
-			else if (getHeight(p->right_) - getHeight(p->left_) == 2){
-				if (p->right_->left_ == 0)
-					singleRightRightRotate(p);
-				else
-					doubleRightLeftRotate(p);
 			}
+			dataAllocator::destroy(temp);
+			storage_.deallocate(temp);
+			--size_;
 		}
+		if (p != 0)//pĽڵ߶Ϣתάƽ
+			p = rebalance(p);
+		return erased;
 	}
-	template<class T>
-	void avl_tree<T>::erase(const T& val){
-		return erase_elem(val, root_);
+	template<class T, class Compare, class NodeStorage>
+	template<class K>
+	typename avl_tree<T, Compare, NodeStorage>::size_type avl_tree<T, Compare, NodeStorage>::erase(const K& key){
+		bool erased = erase_elem(key, root_);
+		if (root_ != 0)
+			root_->parent_ = 0;
+		return erased ? 1 : 0;
+	}
+	//update the height of p and rotate it back into balance, returns the new subtree root
+	//every link change passes through here, so the children of p get their parent too
+	template<class T, class Compare, class NodeStorage>
+	typename avl_tree<T, Compare, NodeStorage>::node *avl_tree<T, Compare, NodeStorage>::rebalance(node *p){
+		if (p->left_ != 0)
+			p->left_->parent_ = p;
+		if (p->right_ != 0)
+			p->right_->parent_ = p;
+		p->height_ = max(getHeight(p->left_), getHeight(p->right_)) + 1;
+		p->weight_ = getWeight(p->left_) + getWeight(p->right_) + 1;
+		if (getHeight(p->left_) > getHeight(p->right_) + 1){
+			if (getHeight(p->left_->left_) >= getHeight(p->left_->right_))
+				p = singleLeftLeftRotate(p);
+			else
+				p = doubleLeftRightRotate(p);
+		}
+		else if (getHeight(p->right_) > getHeight(p->left_) + 1){
+			if (getHeight(p->right_->right_) >= getHeight(p->right_->left_))
+				p = singleRightRightRotate(p);
+			else
+				p = doubleRightLeftRotate(p);
+		}
+		return p;
 	}
-	template<class T>
-	void avl_tree<T>::insert_elem(const T& val, node *&p){
+	//pos is set to the new node, or to the equal node that kept val out of a unique tree
+	template<class T, class Compare, class NodeStorage>
+	bool avl_tree<T, Compare, NodeStorage>::insert_elem(const T& val, node *&p, bool unique, node *&pos){
 		if (p == 0){
-			p = dataAllocator::allocate();
+			p = storage_.allocate();
 			dataAllocator::construct(p);
 			p->data_ = val;
 			p->left_ = p->right_ = 0;
 			p->height_ = 1;
+			p->weight_ = 1;
+			pos = p;
 			++size_;
+			return true;
 		}
-		else if (p->data_ < val){
-			insert_elem(val, p->right_);
-			if (getHeight(p->right_) - getHeight(p->left_) == 2){
-				if (val > p->right_->data_)
-					p = singleRightRightRotate(p);
-				else
-					p = doubleRightLeftRotate(p);
-			}
+		bool inserted = true;
+		if (less(val, p->data_))
+			inserted = insert_elem(val, p->left_, unique, pos);
+		else if (!unique || less(p->data_, val))//an equal value goes right
+			inserted = insert_elem(val, p->right_, unique, pos);
+		else{
+			pos = p;
+			inserted = false;
 		}
-		else if (p->data_ > val){
-			insert_elem(val, p->left_);
-			if (getHeight(p->left_) - getHeight(p->right_) == 2){
-				if (val < p->left_->data_)
-					p = singleLeftLeftRotate(p);
-				else
-					p = doubleLeftRightRotate(p);
-			}
-		}
-		p->height_ = max(getHeight(p->left_), getHeight(p->right_)) + 1;
+		p = rebalance(p);
+		return inserted;
 	}
-	template<class T>
-	void avl_tree<T>::insert(const T& val){
-		return insert_elem(val, root_);
+	template<class T, class Compare, class NodeStorage>
+	MySTL::pair<typename avl_tree<T, Compare, NodeStorage>::const_iterator, bool> avl_tree<T, Compare, NodeStorage>::insert(const T& val){
+		node *pos;
+		bool inserted = insert_elem(val, root_, true, pos);
+		root_->parent_ = 0;
+		return MySTL::pair<const_iterator, bool>(const_iterator(pos), inserted);
 	}
-	template<class T>
+	template<class T, class Compare, class NodeStorage>
+	bool avl_tree<T, Compare, NodeStorage>::insert_equal(const T& val){
+		node *pos;
+		bool inserted = insert_elem(val, root_, false, pos);
+		root_->parent_ = 0;
+		return inserted;
+	}
+	template<class T, class Compare, class NodeStorage>
 	template<class Iterator>
-	void avl_tree<T>::insert(Iterator first, Iterator last){
+	void avl_tree<T, Compare, NodeStorage>::insert(Iterator first, Iterator last){
 		for (; first != last; ++first)
 			insert(*first);
 	}
-	template<class T>
-	void avl_tree<T>::print_preorder_aux(const string& delim, std::ostream& os, const node *ptr)const{
+	template<class T, class Compare, class NodeStorage>
+	template<class Iterator>
+	void avl_tree<T, Compare, NodeStorage>::assign_sorted(Iterator first, Iterator last){
+		size_type n = 0;
+		for (auto it = first; it != last; ++it)
+			++n;
+		destroyAndDeallocateAllNodes(root_);
+		root_ = build_sorted(first, n);
+		if (root_ != 0)
+			root_->parent_ = 0;
+		size_ = n;
+	}
+	//build a perfectly balanced tree of the next n values, the left half first so
+	//that the range is read once in order
+	template<class T, class Compare, class NodeStorage>
+	template<class Iterator>
+	typename avl_tree<T, Compare, NodeStorage>::node *avl_tree<T, Compare, NodeStorage>::build_sorted(Iterator& first, size_type n){
+		if (n == 0)
+			return 0;
+		auto left = build_sorted(first, n / 2);
+		auto p = storage_.allocate();
+		dataAllocator::construct(p);
+		p->data_ = *first;
+		++first;
+		p->left_ = left;
+		p->right_ = build_sorted(first, n - n / 2 - 1);
+		if (p->left_ != 0)
+			p->left_->parent_ = p;
+		if (p->right_ != 0)
+			p->right_->parent_ = p;
+		p->height_ = max(getHeight(p->left_), getHeight(p->right_)) + 1;
+		p->weight_ = n;
+		return p;
+	}
+	//the tree of l, mid and r in order, every value of l is before mid and every
+	//value of r after it, l and r may differ in height by any amount
+	template<class T, class Compare, class NodeStorage>
+	typename avl_tree<T, Compare, NodeStorage>::node *avl_tree<T, Compare, NodeStorage>::join(node *l, node *mid, node *r){
+		if (getHeight(l) > getHeight(r) + 1){
+			l->right_ = join(l->right_, mid, r);
+			return rebalance(l);
+		}
+		if (getHeight(r) > getHeight(l) + 1){
+			r->left_ = join(l, mid, r->left_);
+			return rebalance(r);
+		}
+		mid->left_ = l;
+		mid->right_ = r;
+		return rebalance(mid);
+	}
+	template<class T, class Compare, class NodeStorage>
+	typename avl_tree<T, Compare, NodeStorage>::node *avl_tree<T, Compare, NodeStorage>::join2(node *l, node *r){
+		if (r == 0)
+			return l;
+		node *min;
+		r = remove_min(r, min);
+		return join(l, min, r);
+	}
+	template<class T, class Compare, class NodeStorage>
+	typename avl_tree<T, Compare, NodeStorage>::node *avl_tree<T, Compare, NodeStorage>::remove_min(node *p, node *&min){
+		if (p->left_ == 0){
+			min = p;
+			return p->right_;
+		}
+		p->left_ = remove_min(p->left_, min);
+		return rebalance(p);
+	}
+	//split p into the values before val (l) and after it (r), the node equal to val
+	//is returned detached or 0 if there is none
+	template<class T, class Compare, class NodeStorage>
+	typename avl_tree<T, Compare, NodeStorage>::node *avl_tree<T, Compare, NodeStorage>::split(node *p, const T& val, node *&l, node *&r){
+		if (p == 0){
+			l = r = 0;
+			return 0;
+		}
+		node *found = p;
+		auto left = p->left_, right = p->right_;
+		if (less(val, p->data_)){
+			found = split(left, val, l, r);
+			r = join(r, p, right);
+		}
+		else if (less(p->data_, val)){
+			found = split(right, val, l, r);
+			l = join(left, p, l);
+		}
+		else{
+			l = left;
+			r = right;
+		}
+		return found;
+	}
+	template<class T, class Compare, class NodeStorage>
+	typename avl_tree<T, Compare, NodeStorage>::node *avl_tree<T, Compare, NodeStorage>::unite_aux(node *p, node *q){
+		if (p == 0)
+			return q;
+		if (q == 0)
+			return p;
+		node *l, *r;
+		auto dup = split(q, p->data_, l, r);
+		if (dup != 0){
+			dataAllocator::destroy(dup);
+			storage_.deallocate(dup);
+		}
+		auto left = unite_aux(p->left_, l);
+		auto right = unite_aux(p->right_, r);
+		return join(left, p, right);
+	}
+	template<class T, class Compare, class NodeStorage>
+	typename avl_tree<T, Compare, NodeStorage>::node *avl_tree<T, Compare, NodeStorage>::intersect_aux(node *p, node *q){
+		if (p == 0 || q == 0){
+			destroyAndDeallocateAllNodes(p);
+			destroyAndDeallocateAllNodes(q);
+			return 0;
+		}
+		node *l, *r;
+		auto dup = split(q, p->data_, l, r);
+		auto left = intersect_aux(p->left_, l);
+		auto right = intersect_aux(p->right_, r);
+		if (dup != 0){
+			dataAllocator::destroy(dup);
+			storage_.deallocate(dup);
+			return join(left, p, right);
+		}
+		dataAllocator::destroy(p);
+		storage_.deallocate(p);
+		return join2(left, right);
+	}
+	template<class T, class Compare, class NodeStorage>
+	void avl_tree<T, Compare, NodeStorage>::unite(avl_tree& other){
+		if (&other == this)
+			return;
+		storage_.merge(other.storage_);//the nodes of other are kept or released here
+		root_ = unite_aux(root_, other.root_);
+		if (root_ != 0)
+			root_->parent_ = 0;
+		size_ = getWeight(root_);
+		other.root_ = 0;
+		other.size_ = 0;
+	}
+	template<class T, class Compare, class NodeStorage>
+	void avl_tree<T, Compare, NodeStorage>::intersect(avl_tree& other){
+		if (&other == this)
+			return;
+		storage_.merge(other.storage_);
+		root_ = intersect_aux(root_, other.root_);
+		if (root_ != 0)
+			root_->parent_ = 0;
+		size_ = getWeight(root_);
+		other.root_ = 0;
+		other.size_ = 0;
+	}
+	template<class T, class Compare, class NodeStorage>
+	void avl_tree<T, Compare, NodeStorage>::compact(){
+		storage_type fresh;
+		root_ = compact_aux(root_, fresh);
+		if (root_ != 0)
+			root_->parent_ = 0;
+		storage_.swap(fresh);//the old slabs go away with fresh
+	}
+	//copy the subtree of p into fresh in in-order sequence and release the old nodes
+	template<class T, class Compare, class NodeStorage>
+	typename avl_tree<T, Compare, NodeStorage>::node *avl_tree<T, Compare, NodeStorage>::compact_aux(node *p, storage_type& fresh){
+		if (p == 0)
+			return 0;
+		auto left = compact_aux(p->left_, fresh);
+		auto q = fresh.allocate();
+		dataAllocator::construct(q, *p);
+		q->left_ = left;
+		q->right_ = compact_aux(p->right_, fresh);
+		if (q->left_ != 0)
+			q->left_->parent_ = q;
+		if (q->right_ != 0)
+			q->right_->parent_ = q;
+		dataAllocator::destroy(p);
+		storage_.deallocate(p);
+		return q;
+	}
+	template<class T, class Compare, class NodeStorage>
+	void avl_tree<T, Compare, NodeStorage>::print_preorder_aux(const string& delim, std::ostream& os, const node *ptr)const{
 		if (ptr != 0){
 			os << ptr->data_ << delim;
 			print_preorder_aux(delim, os, ptr->left_);
 			print_preorder_aux(delim, os, ptr->right_);
 		}
 	}
-	template<class T>
-	void avl_tree<T>::print_preorder(const string& delim, std::ostream& os)const{
+	template<class T, class Compare, class NodeStorage>
+	void avl_tree<T, Compare, NodeStorage>::print_preorder(const string& delim, std::ostream& os)const{
 		print_preorder_aux(delim, os, root_);
 	}
-	template<class T>
-	void avl_tree<T>::print_inorder_aux(const string& delim, std::ostream& os, const node *ptr)const{
+	template<class T, class Compare, class NodeStorage>
+	void avl_tree<T, Compare, NodeStorage>::print_inorder_aux(const string& delim, std::ostream& os, const node *ptr)const{
 		if (ptr != 0){
 			print_inorder_aux(delim, os, ptr->left_);
 			os << ptr->data_ << delim;
 			print_inorder_aux(delim, os, ptr->right_);
 		}
 	}
-	template<class T>
-	void avl_tree<T>::print_inorder(const string& delim, std::ostream& os)const{
+	template<class T, class Compare, class NodeStorage>
+	void avl_tree<T, Compare, NodeStorage>::print_inorder(const string& delim, std::ostream& os)const{
 		print_inorder_aux(delim, os, root_);
 	}
-	template<class T>
-	void avl_tree<T>::print_postorder_aux(const string& delim, std::ostream& os, const node *ptr)const{
+	template<class T, class Compare, class NodeStorage>
+	void avl_tree<T, Compare, NodeStorage>::print_postorder_aux(const string& delim, std::ostream& os, const node *ptr)const{
 		if (ptr != 0){
 			print_postorder_aux(delim, os, ptr->left_);
 			print_postorder_aux(delim, os, ptr->right_);
 			os << ptr->data_ << delim;
 		}
 	}
-	template<class T>
-	void avl_tree<T>::print_postorder(const string& delim, std::ostream& os)const{
+	template<class T, class Compare, class NodeStorage>
+	void avl_tree<T, Compare, NodeStorage>::print_postorder(const string& delim, std::ostream& os)const{
 		print_postorder_aux(delim, os, root_);
 	}
-	template<class T>
-	void avl_tree<T>::print_levelorder(const string& delim, std::ostream& os)const{
+	template<class T, class Compare, class NodeStorage>
+	void avl_tree<T, Compare, NodeStorage>::print_levelorder(const string& delim, std::ostream& os)const{
 		auto temp = root_;
 		if (temp != 0){
 			std::deque<node *> q;
@@ -245,40 +432,99 @@ namespace MySTL{
 			}
 		}
 	}
-	template<class T>
-	typename avl_tree<T>::const_iterator avl_tree<T>::find_aux(const T& val, const node *ptr)const{
+	template<class T, class Compare, class NodeStorage>
+	template<class K>
+	typename avl_tree<T, Compare, NodeStorage>::const_iterator avl_tree<T, Compare, NodeStorage>::find(const K& key)const{
+		auto ptr = root_;
 		while (ptr != 0){
-			if (ptr->data_ < val)
+			if (Compare()(ptr->data_, key))
 				ptr = ptr->right_;
-			else if (ptr->data_ > val)
+			else if (Compare()(key, ptr->data_))
 				ptr = ptr->left_;
 			else
 				break;
 		}
-		return const_iterator(ptr, this);
+		return const_iterator(ptr);
+	}
+	template<class T, class Compare, class NodeStorage>
+	template<class K>
+	typename avl_tree<T, Compare, NodeStorage>::const_iterator avl_tree<T, Compare, NodeStorage>::lower_bound(const K& key)const{
+		const node *res = 0;
+		for (auto ptr = root_; ptr != 0;){
+			if (Compare()(ptr->data_, key)){
+				ptr = ptr->right_;
+			}
+			else{
+				res = ptr;
+				ptr = ptr->left_;
+			}
+		}
+		return const_iterator(res);
+	}
+	template<class T, class Compare, class NodeStorage>
+	template<class K>
+	typename avl_tree<T, Compare, NodeStorage>::const_iterator avl_tree<T, Compare, NodeStorage>::upper_bound(const K& key)const{
+		const node *res = 0;
+		for (auto ptr = root_; ptr != 0;){
+			if (Compare()(key, ptr->data_)){
+				res = ptr;
+				ptr = ptr->left_;
+			}
+			else{
+				ptr = ptr->right_;
+			}
+		}
+		return const_iterator(res);
+	}
+	template<class T, class Compare, class NodeStorage>
+	typename avl_tree<T, Compare, NodeStorage>::const_iterator avl_tree<T, Compare, NodeStorage>::select(size_type k)const{
+		if (k >= size_)
+			return cend();
+		auto ptr = root_;
+		for (auto rest = k; getWeight(ptr->left_) != rest;){
+			if (rest < getWeight(ptr->left_)){
+				ptr = ptr->left_;
+			}
+			else{
+				rest -= getWeight(ptr->left_) + 1;
+				ptr = ptr->right_;
+			}
+		}
+		return const_iterator(ptr);
 	}
-	template<class T>
-	typename avl_tree<T>::const_iterator avl_tree<T>::find(const T& val)const{
-		return find_aux(val, root_);
+	template<class T, class Compare, class NodeStorage>
+	template<class K>
+	typename avl_tree<T, Compare, NodeStorage>::size_type avl_tree<T, Compare, NodeStorage>::rank(const K& key)const{
+		size_type res = 0;
+		for (auto ptr = root_; ptr != 0;){
+			if (Compare()(ptr->data_, key)){
+				res += getWeight(ptr->left_) + 1;
+				ptr = ptr->right_;
+			}
+			else{
+				ptr = ptr->left_;
+			}
+		}
+		return res;
 	}
-	template<class T>
-	typename avl_tree<T>::const_iterator avl_tree<T>::find_max_aux(const node *ptr)const{
+	template<class T, class Compare, class NodeStorage>
+	typename avl_tree<T, Compare, NodeStorage>::const_iterator avl_tree<T, Compare, NodeStorage>::find_max_aux(const node *ptr)const{
 		while (ptr != 0 && ptr->right_ != 0)
 			ptr = ptr->right_;
-		return const_iterator(ptr, this);
+		return const_iterator(ptr);
 	}
-	template<class T>
-	typename avl_tree<T>::const_iterator avl_tree<T>::find_max()const{
+	template<class T, class Compare, class NodeStorage>
+	typename avl_tree<T, Compare, NodeStorage>::const_iterator avl_tree<T, Compare, NodeStorage>::find_max()const{
 		return find_max_aux(root_);
 	}
-	template<class T>
-	typename avl_tree<T>::const_iterator avl_tree<T>::find_min_aux(const node *ptr)const{
+	template<class T, class Compare, class NodeStorage>
+	typename avl_tree<T, Compare, NodeStorage>::const_iterator avl_tree<T, Compare, NodeStorage>::find_min_aux(const node *ptr)const{
 		while (ptr != 0 && ptr->left_ != 0)
 			ptr = ptr->left_;
-		return const_iterator(ptr, this);
+		return const_iterator(ptr);
 	}
-	template<class T>
-	typename avl_tree<T>::const_iterator avl_tree<T>::find_min()const{
+	template<class T, class Compare, class NodeStorage>
+	typename avl_tree<T, Compare, NodeStorage>::const_iterator avl_tree<T, Compare, NodeStorage>::find_min()const{
 		return find_min_aux(root_);
 	}
 }
@@ -1,6 +1,15 @@
 #include "Alloc.h"
 
+#include <mutex>
+
 namespace MySTL{
+	namespace{
+		std::mutex pool_mutex;// guards the shared free-lists and the memory pool
+		// set when the thread_cache of this thread is destroyed, the main thread's goes
+		// before the static objects whose destructors may still free memory, so from
+		// then on the thread works on the shared free-lists under the lock
+		thread_local bool cache_destroyed = false;
+	}
 
 	char *alloc::start_free = nullptr;
 	char *alloc::end_free = nullptr;
@@ -10,14 +19,55 @@ namespace MySTL{
 		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
 	};
 
+	struct alloc::thread_cache{
+		obj *free_list[ENFreeLists::NFREELISTS];
+		size_t count[ENFreeLists::NFREELISTS];
+		thread_cache(){
+			for (size_t i = 0; i != ENFreeLists::NFREELISTS; ++i){
+				free_list[i] = nullptr;
+				count[i] = 0;
+			}
+		}
+		~thread_cache(){// the blocks of an exiting thread go back to the pool
+			for (size_t i = 0; i != ENFreeLists::NFREELISTS; ++i)
+				trim(*this, i, 0);
+			cache_destroyed = true;
+		}
+	};
+
+	alloc::thread_cache& alloc::local_cache(){
+		static thread_local thread_cache cache;
+		return cache;
+	}
+
+	void alloc::trim(thread_cache& cache, size_t index, size_t keep){
+		if (cache.count[index] <= keep)
+			return;
+		obj **link = &cache.free_list[index];
+		for (size_t i = 0; i != keep; ++i)
+			link = &(*link)->next;
+		obj *first = *link, *last = first;
+		while (last->next != nullptr)
+			last = last->next;
+		*link = nullptr;
+		cache.count[index] = keep;
+		std::lock_guard<std::mutex> guard(pool_mutex);
+		last->next = free_list[index];
+		free_list[index] = first;
+	}
+
 	void *alloc::allocate(size_t bytes){
 		if (bytes > EMaxBytes::MAXBYTES){
 			return malloc(bytes);
 		}
+		if (cache_destroyed)
+			return allocate_shared(bytes);
+		thread_cache& cache = local_cache();
 		size_t index = FREELIST_INDEX(bytes);
-		obj *list = free_list[index];
+		obj *list = cache.free_list[index];
 		if (list){// listпռԷ
-			free_list[index] = list->next;
+			cache.free_list[index] = list->next;
+			--cache.count[index];
 			return list;
 		}
 		else{// listû㹻Ŀռ䣬Ҫڴȡռ
@@ -29,12 +79,38 @@ namespace MySTL{
 		if (bytes > EMaxBytes::MAXBYTES){
 			free(ptr);
 		}
+		else if (cache_destroyed){
+			deallocate_shared(ptr, bytes);
+		}
 		else{
+			thread_cache& cache = local_cache();
 			size_t index = FREELIST_INDEX(bytes);
 			obj *node = static_cast<obj *>(ptr);
-			node->next = free_list[index];
-			free_list[index] = node;
+			node->next = cache.free_list[index];
+			cache.free_list[index] = node;
+			if (++cache.count[index] > EMaxCached::MAXCACHED)
+				trim(cache, index, ENObjs::NOBJS);
+		}
+	}
+
+	void *alloc::allocate_shared(size_t bytes){
+		std::lock_guard<std::mutex> guard(pool_mutex);
+		obj **my_free_list = free_list + FREELIST_INDEX(bytes);
+		obj *result = *my_free_list;
+		if (result){
+			*my_free_list = result->next;
+			return result;
 		}
+		size_t nobjs = 1;
+		return chunk_alloc(ROUND_UP(bytes), nobjs);
+	}
+
+	void alloc::deallocate_shared(void *ptr, size_t bytes){
+		std::lock_guard<std::mutex> guard(pool_mutex);
+		obj **my_free_list = free_list + FREELIST_INDEX(bytes);
+		obj *node = static_cast<obj *>(ptr);
+		node->next = *my_free_list;
+		*my_free_list = node;
 	}
 
 	void *alloc::reallocalte(void *ptr, size_t old_sz, size_t new_sz){
@@ -45,10 +121,28 @@ namespace MySTL{
 
 	// һСΪnĶ󣬲ʱΪʵfree-listӽڵ
 	// bytesѾϵΪ8ı
+	// the blocks go to the free-list of the calling thread, which is empty here
 	void *alloc::refill(size_t bytes){
+		thread_cache& cache = local_cache();
 		size_t nobjs = ENObjs::NOBJS;
-		// ڴȡ
-		char *chunk = chunk_alloc(bytes, nobjs);
+		char *chunk = nullptr;
+		{
+			std::lock_guard<std::mutex> guard(pool_mutex);
+			obj *list = free_list[FREELIST_INDEX(bytes)];
+			if (list){// take up to nobjs blocks that other threads gave back
+				obj *last = list;
+				size_t n = 1;
+				for (; n != nobjs && last->next != nullptr; ++n)
+					last = last->next;
+				free_list[FREELIST_INDEX(bytes)] = last->next;
+				last->next = nullptr;
+				cache.free_list[FREELIST_INDEX(bytes)] = list->next;
+				cache.count[FREELIST_INDEX(bytes)] = n - 1;
+				return list;
+			}
+			// ڴȡ
+			chunk = chunk_alloc(bytes, nobjs);
+		}
 		obj **my_free_list = nullptr;
 		obj *result = nullptr;
 		obj *current_obj = nullptr, *next_obj = nullptr;
@@ -57,7 +151,8 @@ namespace MySTL{
 			return chunk;
 		}
 		else{
-			my_free_list = free_list + FREELIST_INDEX(bytes);
+			my_free_list = cache.free_list + FREELIST_INDEX(bytes);
+			cache.count[FREELIST_INDEX(bytes)] = nobjs - 1;
 			result = (obj *)(chunk);
 			*my_free_list = next_obj = (obj *)(chunk + bytes);
 			// ȡĶĿռ뵽Ӧfree-listȥ
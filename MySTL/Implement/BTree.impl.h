@@ -0,0 +1,427 @@
+#ifndef _BTREE_IMPL_H_
+#define _BTREE_IMPL_H_
+
+namespace MySTL{
+	namespace Detail{
+		template<class Value, class Tree>
+		btree_iter<Value, Tree>& btree_iter<Value, Tree>::operator ++(){
+			if (++slot_ == leaf_->count_){
+				leaf_ = leaf_->next_;
+				slot_ = 0;
+			}
+			return *this;
+		}
+		template<class Value, class Tree>
+		btree_iter<Value, Tree> btree_iter<Value, Tree>::operator ++(int){
+			auto res = *this;
+			++*this;
+			return res;
+		}
+		template<class Value, class Tree>
+		btree_iter<Value, Tree>& btree_iter<Value, Tree>::operator --(){
+			if (leaf_ == 0){//--end()
+				leaf_ = container_->tail_;
+				slot_ = leaf_->count_ - 1;
+			}
+			else if (slot_ == 0){
+				leaf_ = leaf_->prev_;
+				slot_ = leaf_->count_ - 1;
+			}
+			else{
+				--slot_;
+			}
+			return *this;
+		}
+		template<class Value, class Tree>
+		btree_iter<Value, Tree> btree_iter<Value, Tree>::operator --(int){
+			auto res = *this;
+			--*this;
+			return res;
+		}
+
+		template<class Key, class Value, class KeyOfValue, class Compare, class Access>
+		typename btree<Key, Value, KeyOfValue, Compare, Access>::leaf_node *btree<Key, Value, KeyOfValue, Compare, Access>::new_leaf(){
+			auto leaf = leafAllocator::allocate();
+			leafAllocator::construct(leaf);
+			return leaf;
+		}
+		template<class Key, class Value, class KeyOfValue, class Compare, class Access>
+		typename btree<Key, Value, KeyOfValue, Compare, Access>::inner_node *btree<Key, Value, KeyOfValue, Compare, Access>::new_inner(){
+			auto inner = innerAllocator::allocate();
+			innerAllocator::construct(inner);
+			return inner;
+		}
+		template<class Key, class Value, class KeyOfValue, class Compare, class Access>
+		void btree<Key, Value, KeyOfValue, Compare, Access>::delete_leaf(leaf_node *leaf){
+			leafAllocator::destroy(leaf);
+			leafAllocator::deallocate(leaf);
+		}
+		template<class Key, class Value, class KeyOfValue, class Compare, class Access>
+		void btree<Key, Value, KeyOfValue, Compare, Access>::delete_inner(inner_node *inner){
+			innerAllocator::destroy(inner);
+			innerAllocator::deallocate(inner);
+		}
+		template<class Key, class Value, class KeyOfValue, class Compare, class Access>
+		void btree<Key, Value, KeyOfValue, Compare, Access>::destroy(node *p){
+			if (p->leaf_){
+				delete_leaf(static_cast<leaf_node *>(p));
+				return;
+			}
+			auto inner = static_cast<inner_node *>(p);
+			for (size_t i = 0; i <= inner->count_; ++i)
+				destroy(inner->children_[i]);
+			delete_inner(inner);
+		}
+		template<class Key, class Value, class KeyOfValue, class Compare, class Access>
+		void btree<Key, Value, KeyOfValue, Compare, Access>::clear(){
+			if (root_ != 0)
+				destroy(root_);
+			root_ = 0;
+			head_ = tail_ = 0;
+			size_ = 0;
+		}
+		template<class Key, class Value, class KeyOfValue, class Compare, class Access>
+		typename btree<Key, Value, KeyOfValue, Compare, Access>::size_type btree<Key, Value, KeyOfValue, Compare, Access>::height()const{
+			size_type h = 0;
+			for (auto p = root_; p != 0; ++h){
+				if (p->leaf_)
+					p = 0;
+				else
+					p = static_cast<inner_node *>(p)->children_[0];
+			}
+			return h;
+		}
+
+		template<class Key, class Value, class KeyOfValue, class Compare, class Access>
+		size_t btree<Key, Value, KeyOfValue, Compare, Access>::leaf_lower_bound(const leaf_node *leaf, const key_type& key){
+			size_t lo = 0, hi = leaf->count_;
+			while (lo < hi){
+				size_t mid = lo + (hi - lo) / 2;
+				if (less(KeyOfValue()(leaf->values_[mid]), key))
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+			return lo;
+		}
+		template<class Key, class Value, class KeyOfValue, class Compare, class Access>
+		size_t btree<Key, Value, KeyOfValue, Compare, Access>::leaf_upper_bound(const leaf_node *leaf, const key_type& key){
+			size_t lo = 0, hi = leaf->count_;
+			while (lo < hi){
+				size_t mid = lo + (hi - lo) / 2;
+				if (less(key, KeyOfValue()(leaf->values_[mid])))
+					hi = mid;
+				else
+					lo = mid + 1;
+			}
+			return lo;
+		}
+		template<class Key, class Value, class KeyOfValue, class Compare, class Access>
+		size_t btree<Key, Value, KeyOfValue, Compare, Access>::inner_upper_bound(const inner_node *inner, const key_type& key){
+			size_t lo = 0, hi = inner->count_;
+			while (lo < hi){
+				size_t mid = lo + (hi - lo) / 2;
+				if (less(key, inner->keys_[mid]))
+					hi = mid;
+				else
+					lo = mid + 1;
+			}
+			return lo;
+		}
+		template<class Key, class Value, class KeyOfValue, class Compare, class Access>
+		typename btree<Key, Value, KeyOfValue, Compare, Access>::leaf_node *btree<Key, Value, KeyOfValue, Compare, Access>::find_leaf(const key_type& key)const{
+			auto p = root_;
+			while (!p->leaf_){
+				auto inner = static_cast<inner_node *>(p);
+				p = inner->children_[inner_upper_bound(inner, key)];
+			}
+			return static_cast<leaf_node *>(p);
+		}
+		template<class Key, class Value, class KeyOfValue, class Compare, class Access>
+		typename btree<Key, Value, KeyOfValue, Compare, Access>::iterator btree<Key, Value, KeyOfValue, Compare, Access>::make_iter(leaf_node *leaf, size_t slot)const{
+			if (slot == leaf->count_)//the answer is the first value of the next leaf
+				return iterator(leaf->next_, 0, this);
+			return iterator(leaf, slot, this);
+		}
+		template<class Key, class Value, class KeyOfValue, class Compare, class Access>
+		typename btree<Key, Value, KeyOfValue, Compare, Access>::iterator btree<Key, Value, KeyOfValue, Compare, Access>::lower_bound(const key_type& key)const{
+			if (root_ == 0)
+				return end();
+			auto leaf = find_leaf(key);
+			return make_iter(leaf, leaf_lower_bound(leaf, key));
+		}
+		template<class Key, class Value, class KeyOfValue, class Compare, class Access>
+		typename btree<Key, Value, KeyOfValue, Compare, Access>::iterator btree<Key, Value, KeyOfValue, Compare, Access>::upper_bound(const key_type& key)const{
+			if (root_ == 0)
+				return end();
+			auto leaf = find_leaf(key);
+			return make_iter(leaf, leaf_upper_bound(leaf, key));
+		}
+		template<class Key, class Value, class KeyOfValue, class Compare, class Access>
+		typename btree<Key, Value, KeyOfValue, Compare, Access>::iterator btree<Key, Value, KeyOfValue, Compare, Access>::find(const key_type& key)const{
+			if (root_ == 0)
+				return end();
+			auto leaf = find_leaf(key);
+			auto slot = leaf_lower_bound(leaf, key);
+			if (slot == leaf->count_ || less(key, KeyOfValue()(leaf->values_[slot])))
+				return end();
+			return iterator(leaf, slot, this);
+		}
+
+		template<class Key, class Value, class KeyOfValue, class Compare, class Access>
+		MySTL::pair<typename btree<Key, Value, KeyOfValue, Compare, Access>::iterator, bool>
+			btree<Key, Value, KeyOfValue, Compare, Access>::insert(const value_type& val){
+			if (root_ == 0)
+				root_ = head_ = tail_ = new_leaf();
+			iterator pos;
+			key_type split_key;
+			node *split_node = 0;
+			bool inserted = insert_aux(root_, val, pos, split_key, split_node);
+			if (split_node != 0){//the tree grows at the root
+				auto root = new_inner();
+				root->count_ = 1;
+				root->keys_[0] = split_key;
+				root->children_[0] = root_;
+				root->children_[1] = split_node;
+				root_ = root;
+			}
+			if (inserted)
+				++size_;
+			return MySTL::pair<iterator, bool>(pos, inserted);
+		}
+		template<class Key, class Value, class KeyOfValue, class Compare, class Access>
+		template<class InputIterator>
+		void btree<Key, Value, KeyOfValue, Compare, Access>::insert(InputIterator first, InputIterator last){
+			for (; first != last; ++first)
+				insert(*first);
+		}
+		template<class Key, class Value, class KeyOfValue, class Compare, class Access>
+		bool btree<Key, Value, KeyOfValue, Compare, Access>::insert_aux(node *p, const value_type& val,
+			iterator& pos, key_type& split_key, node *&split_node){
+			const key_type& key = KeyOfValue()(val);
+			if (p->leaf_){
+				auto leaf = static_cast<leaf_node *>(p);
+				size_t slot = leaf_lower_bound(leaf, key);
+				if (slot != leaf->count_ && !less(key, KeyOfValue()(leaf->values_[slot]))){
+					pos = iterator(leaf, slot, this);
+					return false;
+				}
+				if (leaf->count_ < LEAF_SLOTS){
+					for (size_t i = leaf->count_; i > slot; --i)
+						leaf->values_[i] = leaf->values_[i - 1];
+					leaf->values_[slot] = val;
+					++leaf->count_;
+					pos = iterator(leaf, slot, this);
+					return true;
+				}
+				//split the full leaf, the upper half of the LEAF_SLOTS + 1 values moves right
+				auto right = new_leaf();
+				const size_t total = LEAF_SLOTS + 1, left_count = total / 2;
+				for (size_t i = total; i-- > left_count;)
+					right->values_[i - left_count] = (i == slot ? val : leaf->values_[i < slot ? i : i - 1]);
+				if (slot < left_count){
+					for (size_t i = left_count - 1; i > slot; --i)
+						leaf->values_[i] = leaf->values_[i - 1];
+					leaf->values_[slot] = val;
+				}
+				for (size_t i = left_count; i != LEAF_SLOTS; ++i)
+					leaf->values_[i] = value_type();
+				leaf->count_ = left_count;
+				right->count_ = total - left_count;
+				right->prev_ = leaf;
+				right->next_ = leaf->next_;
+				if (right->next_ != 0)
+					right->next_->prev_ = right;
+				else
+					tail_ = right;
+				leaf->next_ = right;
+				pos = slot < left_count ? iterator(leaf, slot, this) : iterator(right, slot - left_count, this);
+				split_key = KeyOfValue()(right->values_[0]);
+				split_node = right;
+				return true;
+			}
+			auto inner = static_cast<inner_node *>(p);
+			size_t i = inner_upper_bound(inner, key);
+			key_type child_key;
+			node *child_split = 0;
+			bool inserted = insert_aux(inner->children_[i], val, pos, child_key, child_split);
+			if (child_split == 0)
+				return inserted;
+			if (inner->count_ < INNER_SLOTS){
+				for (size_t j = inner->count_; j > i; --j){
+					inner->keys_[j] = inner->keys_[j - 1];
+					inner->children_[j + 1] = inner->children_[j];
+				}
+				inner->keys_[i] = child_key;
+				inner->children_[i + 1] = child_split;
+				++inner->count_;
+				return inserted;
+			}
+			//split the full inner node, the middle key moves up to the parent
+			key_type keys[INNER_SLOTS + 1];
+			node *children[INNER_SLOTS + 2];
+			for (size_t j = 0, k = 0; j != INNER_SLOTS + 1; ++j)
+				keys[j] = (j == i ? child_key : inner->keys_[k++]);
+			for (size_t j = 0, k = 0; j != INNER_SLOTS + 2; ++j)
+				children[j] = (j == i + 1 ? child_split : inner->children_[k++]);
+			const size_t mid = (INNER_SLOTS + 1) / 2;
+			auto right = new_inner();
+			inner->count_ = mid;
+			for (size_t j = 0; j != mid; ++j){
+				inner->keys_[j] = keys[j];
+				inner->children_[j] = children[j];
+			}
+			inner->children_[mid] = children[mid];
+			right->count_ = INNER_SLOTS - mid;
+			for (size_t j = 0; j != right->count_; ++j){
+				right->keys_[j] = keys[mid + 1 + j];
+				right->children_[j] = children[mid + 1 + j];
+			}
+			right->children_[right->count_] = children[INNER_SLOTS + 1];
+			split_key = keys[mid];
+			split_node = right;
+			return inserted;
+		}
+
+		template<class Key, class Value, class KeyOfValue, class Compare, class Access>
+		typename btree<Key, Value, KeyOfValue, Compare, Access>::size_type btree<Key, Value, KeyOfValue, Compare, Access>::erase(const key_type& key){
+			if (root_ == 0 || !erase_aux(root_, key))
+				return 0;
+			--size_;
+			if (root_->leaf_ && root_->count_ == 0){
+				delete_leaf(static_cast<leaf_node *>(root_));
+				root_ = head_ = tail_ = 0;
+			}
+			else if (!root_->leaf_ && root_->count_ == 0){//the tree shrinks at the root
+				auto old = static_cast<inner_node *>(root_);
+				root_ = old->children_[0];
+				delete_inner(old);
+			}
+			return 1;
+		}
+		template<class Key, class Value, class KeyOfValue, class Compare, class Access>
+		bool btree<Key, Value, KeyOfValue, Compare, Access>::erase_aux(node *p, const key_type& key){
+			if (p->leaf_){
+				auto leaf = static_cast<leaf_node *>(p);
+				size_t slot = leaf_lower_bound(leaf, key);
+				if (slot == leaf->count_ || less(key, KeyOfValue()(leaf->values_[slot])))
+					return false;
+				for (size_t i = slot + 1; i != leaf->count_; ++i)
+					leaf->values_[i - 1] = leaf->values_[i];
+				leaf->values_[--leaf->count_] = value_type();
+				return true;
+			}
+			auto inner = static_cast<inner_node *>(p);
+			size_t i = inner_upper_bound(inner, key);
+			if (!erase_aux(inner->children_[i], key))
+				return false;
+			auto child = inner->children_[i];
+			if (child->count_ < (child->leaf_ ? LEAF_SLOTS : INNER_SLOTS) / 2)
+				fix_child(inner, i);
+			return true;
+		}
+		//the child i of parent is under half full, borrow one from a sibling or merge with it
+		template<class Key, class Value, class KeyOfValue, class Compare, class Access>
+		void btree<Key, Value, KeyOfValue, Compare, Access>::fix_child(inner_node *parent, size_t i){
+			if (parent->children_[i]->leaf_){
+				auto child = static_cast<leaf_node *>(parent->children_[i]);
+				auto left = i != 0 ? static_cast<leaf_node *>(parent->children_[i - 1]) : 0;
+				auto right = i != parent->count_ ? static_cast<leaf_node *>(parent->children_[i + 1]) : 0;
+				if (left != 0 && left->count_ > LEAF_SLOTS / 2){
+					for (size_t j = child->count_; j != 0; --j)
+						child->values_[j] = child->values_[j - 1];
+					child->values_[0] = left->values_[left->count_ - 1];
+					left->values_[--left->count_] = value_type();
+					++child->count_;
+					parent->keys_[i - 1] = KeyOfValue()(child->values_[0]);
+				}
+				else if (right != 0 && right->count_ > LEAF_SLOTS / 2){
+					child->values_[child->count_++] = right->values_[0];
+					for (size_t j = 1; j != right->count_; ++j)
+						right->values_[j - 1] = right->values_[j];
+					right->values_[--right->count_] = value_type();
+					parent->keys_[i] = KeyOfValue()(right->values_[0]);
+				}
+				else if (left != 0){
+					merge_leaves(parent, i - 1);
+				}
+				else{
+					merge_leaves(parent, i);
+				}
+				return;
+			}
+			auto child = static_cast<inner_node *>(parent->children_[i]);
+			auto left = i != 0 ? static_cast<inner_node *>(parent->children_[i - 1]) : 0;
+			auto right = i != parent->count_ ? static_cast<inner_node *>(parent->children_[i + 1]) : 0;
+			if (left != 0 && left->count_ > INNER_SLOTS / 2){//rotate through the separator
+				child->children_[child->count_ + 1] = child->children_[child->count_];
+				for (size_t j = child->count_; j != 0; --j){
+					child->keys_[j] = child->keys_[j - 1];
+					child->children_[j] = child->children_[j - 1];
+				}
+				child->keys_[0] = parent->keys_[i - 1];
+				child->children_[0] = left->children_[left->count_];
+				parent->keys_[i - 1] = left->keys_[left->count_ - 1];
+				--left->count_;
+				++child->count_;
+			}
+			else if (right != 0 && right->count_ > INNER_SLOTS / 2){
+				child->keys_[child->count_] = parent->keys_[i];
+				child->children_[child->count_ + 1] = right->children_[0];
+				++child->count_;
+				parent->keys_[i] = right->keys_[0];
+				for (size_t j = 1; j != right->count_; ++j)
+					right->keys_[j - 1] = right->keys_[j];
+				for (size_t j = 1; j != right->count_ + 1; ++j)
+					right->children_[j - 1] = right->children_[j];
+				--right->count_;
+			}
+			else if (left != 0){
+				merge_inners(parent, i - 1);
+			}
+			else{
+				merge_inners(parent, i);
+			}
+		}
+		//merge children i + 1 into children i of parent
+		template<class Key, class Value, class KeyOfValue, class Compare, class Access>
+		void btree<Key, Value, KeyOfValue, Compare, Access>::merge_leaves(inner_node *parent, size_t i){
+			auto left = static_cast<leaf_node *>(parent->children_[i]);
+			auto right = static_cast<leaf_node *>(parent->children_[i + 1]);
+			for (size_t j = 0; j != right->count_; ++j)
+				left->values_[left->count_ + j] = right->values_[j];
+			left->count_ += right->count_;
+			left->next_ = right->next_;
+			if (left->next_ != 0)
+				left->next_->prev_ = left;
+			else
+				tail_ = left;
+			delete_leaf(right);
+			remove_child(parent, i);
+		}
+		template<class Key, class Value, class KeyOfValue, class Compare, class Access>
+		void btree<Key, Value, KeyOfValue, Compare, Access>::merge_inners(inner_node *parent, size_t i){
+			auto left = static_cast<inner_node *>(parent->children_[i]);
+			auto right = static_cast<inner_node *>(parent->children_[i + 1]);
+			left->keys_[left->count_] = parent->keys_[i];
+			for (size_t j = 0; j != right->count_; ++j)
+				left->keys_[left->count_ + 1 + j] = right->keys_[j];
+			for (size_t j = 0; j != right->count_ + 1; ++j)
+				left->children_[left->count_ + 1 + j] = right->children_[j];
+			left->count_ += right->count_ + 1;
+			delete_inner(right);
+			remove_child(parent, i);
+		}
+		//drop keys_[i] and children_[i + 1] of parent
+		template<class Key, class Value, class KeyOfValue, class Compare, class Access>
+		void btree<Key, Value, KeyOfValue, Compare, Access>::remove_child(inner_node *parent, size_t i){
+			for (size_t j = i + 1; j != parent->count_; ++j){
+				parent->keys_[j - 1] = parent->keys_[j];
+				parent->children_[j] = parent->children_[j + 1];
+			}
+			--parent->count_;
+		}
+	}// end of namespace Detail
+}// end of namespace MySTL
+
+#endif
\ No newline at end of file
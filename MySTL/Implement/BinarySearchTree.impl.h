@@ -3,47 +3,21 @@
 
 namespace MySTL{
 	namespace Detail{
-		template<class T>
-		bst_iter<T>::bst_iter(const T *ptr, cntrPtr container)
-			:ptr_(ptr), container_(container){
-			if (!ptr_)
-				return;
-			auto temp = container_->root_;
-			while (temp && temp != ptr_ && temp->data_ != ptr_->data_){
-				parent_.push(temp);
-				if (temp->data_ < ptr_->data_){
-					//temp˵temoָĸڵ㲻Ҫٴη
-					visited_.insert(temp);
-					temp = temp->right_;
-				}
-				else if (temp->data_ > ptr_->data_){
-					temp = temp->left_;
-				}
-			}
-		}
 		template<class T>
 		bst_iter<T>& bst_iter<T>::operator ++(){
-			visited_.insert(ptr_);//node
-			if (ptr_->right_){//node
-				parent_.push(ptr_);
+			if (ptr_->right_){//the leftmost node of the right subtree
 				ptr_ = ptr_->right_;
-				while (ptr_ && ptr_->left_){
-					parent_.push(ptr_);
+				while (ptr_->left_)
 					ptr_ = ptr_->left_;
+			}
+			else{//climb until coming up from a left child, 0 past the last node
+				auto child = ptr_;
+				ptr_ = ptr_->parent_;
+				while (ptr_ && ptr_->right_ == child){
+					child = ptr_;
+					ptr_ = ptr_->parent_;
 				}
 			}
-			else{//nodeֻ򸸽ڵ·ƶ
-				ptr_ = 0;
-				while (!parent_.empty()){
-					ptr_ = parent_.top();
-					parent_.pop();
-					if (visited_.count(ptr_) == 0){//ڵδ,ʱptr_ָ˽ڵ
-						visited_.insert(ptr_);
-						break;
-					}
-					ptr_ = 0;//Ϊڱ
-				}//end of while
-			}//end of if
 			return *this;
 		}
 		template<class T>
@@ -62,21 +36,21 @@ namespace MySTL{
 		}
 	}//end of Detail namespace
 
-	template<class T>
-	binary_search_tree<T>::~binary_search_tree(){
+	template<class T, class NodeStorage>
+	binary_search_tree<T, NodeStorage>::~binary_search_tree(){
 		deallocateAllNodes(root_);
 	}
-	template<class T>
-	void binary_search_tree<T>::deallocateAllNodes(node *ptr){
+	template<class T, class NodeStorage>
+	void binary_search_tree<T, NodeStorage>::deallocateAllNodes(node *ptr){
 		if (ptr){
 			deallocateAllNodes(ptr->left_);
 			deallocateAllNodes(ptr->right_);
 			nodeAllocator::destroy(ptr);
-			nodeAllocator::deallocate(ptr);
+			storage_.deallocate(ptr);
 		}
 	}
-	template<class T>
-	size_t binary_search_tree<T>::height_aux(node *p)const{
+	template<class T, class NodeStorage>
+	size_t binary_search_tree<T, NodeStorage>::height_aux(node *p)const{
 		MySTL::queue<node *> q/*һnode*/, level/*ŵǰnode*/;
 		size_t nlevel = 0;
 		if (p != 0){
@@ -98,8 +72,8 @@ namespace MySTL{
 		}
 		return nlevel;
 	}
-	template<class T>
-	void binary_search_tree<T>::erase_elem(const T& val, node *&ptr){
+	template<class T, class NodeStorage>
+	void binary_search_tree<T, NodeStorage>::erase_elem(const T& val, node *&ptr){
 		if (ptr == 0)
 			return;
 		if (ptr->data_ != val){
@@ -109,60 +83,143 @@ namespace MySTL{
 				return erase_elem(val, ptr->right_);
 		}
 		else{ // found
+			if (ptr->left_ != 0 && ptr->right_ != 0 && balanced_){
+				//rotate the node below its child of higher priority until it has one child
+				if (ptr->left_->priority_ > ptr->right_->priority_){
+					rotate_right(ptr);
+					return erase_elem(val, ptr->right_);
+				}
+				rotate_left(ptr);
+				return erase_elem(val, ptr->left_);
+			}
+			auto temp = ptr;
 			if (ptr->left_ != 0 && ptr->right_ != 0){// has two children
-				size_t choose = size_ % 2;
-				//ѡɾңʹɾƽ
-				auto pos = (choose == 0 ?
-					const_cast<node *>(find_min_aux(ptr->right_).ptr_) : const_cast<node *>(find_max_aux(ptr->left_).ptr_));
-				ptr->data_ = pos->data_;
-				return (choose == 0 ? erase_elem(pos->data_, ptr->right_) : erase_elem(pos->data_, ptr->left_));
+				//unlink the successor node and splice it into the place of ptr,
+				//no data is copied so iterators to other nodes stay valid
+				auto min = ptr->right_;
+				while (min->left_ != 0)
+					min = min->left_;
+				if (min != ptr->right_){
+					min->parent_->left_ = min->right_;
+					if (min->right_ != 0)
+						min->right_->parent_ = min->parent_;
+					min->right_ = ptr->right_;
+					min->right_->parent_ = min;
+				}
+				min->left_ = ptr->left_;
+				min->left_->parent_ = min;
+				ptr = min;
 			}
 			else{ //has one or no child
-				auto temp = ptr;
 				if (ptr->left_ == 0)
 					ptr = ptr->right_;
 				else
 					ptr = ptr->left_;
-				nodeAllocator::destroy(temp);
-				nodeAllocator::deallocate(temp);
-				--size_;
 			}
+			if (ptr != 0)
+				ptr->parent_ = temp->parent_;
+			nodeAllocator::destroy(temp);
+			storage_.deallocate(temp);
+			--size_;
 		}
 	}
-	template<class T>
-	void binary_search_tree<T>::erase(const T& val){
+	template<class T, class NodeStorage>
+	void binary_search_tree<T, NodeStorage>::erase(const T& val){
 		erase_elem(val, root_);
 	}
-	template<class T>
-	void binary_search_tree<T>::insert_elem(const T& val, node *&ptr){//ظԪز
+	template<class T, class NodeStorage>
+	void binary_search_tree<T, NodeStorage>::insert_elem(const T& val, node *&ptr, node *parent){//ظԪز
 		if (ptr == 0){
-			ptr = nodeAllocator::allocate();
+			ptr = storage_.allocate();
 			nodeAllocator::construct(ptr);
 			ptr->data_ = val;
 			ptr->left_ = ptr->right_ = 0;
+			ptr->parent_ = parent;
+			ptr->priority_ = balanced_ ? next_priority() : 0;
 			++size_;
 		}
 		else{
 			if (val < ptr->data_){
-				return insert_elem(val, ptr->left_);
+				insert_elem(val, ptr->left_, ptr);
+				if (balanced_ && ptr->left_->priority_ > ptr->priority_)
+					rotate_right(ptr);
 			}
 			else if (val > ptr->data_){
-				return insert_elem(val, ptr->right_);
+				insert_elem(val, ptr->right_, ptr);
+				if (balanced_ && ptr->right_->priority_ > ptr->priority_)
+					rotate_left(ptr);
 			}
 		}
 	}
-	template<class T>
-	void binary_search_tree<T>::insert(const T& val){
-		insert_elem(val, root_);
+	//the right child of ptr takes its place
+	template<class T, class NodeStorage>
+	void binary_search_tree<T, NodeStorage>::rotate_left(node *&ptr){
+		auto r = ptr->right_;
+		ptr->right_ = r->left_;
+		if (ptr->right_ != 0)
+			ptr->right_->parent_ = ptr;
+		r->left_ = ptr;
+		r->parent_ = ptr->parent_;
+		ptr->parent_ = r;
+		ptr = r;
+	}
+	//the left child of ptr takes its place
+	template<class T, class NodeStorage>
+	void binary_search_tree<T, NodeStorage>::rotate_right(node *&ptr){
+		auto l = ptr->left_;
+		ptr->left_ = l->right_;
+		if (ptr->left_ != 0)
+			ptr->left_->parent_ = ptr;
+		l->right_ = ptr;
+		l->parent_ = ptr->parent_;
+		ptr->parent_ = l;
+		ptr = l;
 	}
-	template<class T>
+	template<class T, class NodeStorage>
+	unsigned int binary_search_tree<T, NodeStorage>::next_priority(){
+		seed_ ^= seed_ << 13;
+		seed_ ^= seed_ >> 7;
+		seed_ ^= seed_ << 17;
+		return static_cast<unsigned int>(seed_ >> 32);
+	}
+	template<class T, class NodeStorage>
+	void binary_search_tree<T, NodeStorage>::insert(const T& val){
+		insert_elem(val, root_, 0);
+	}
+	template<class T, class NodeStorage>
 	template<class Iterator>
-	void binary_search_tree<T>::insert(Iterator first, Iterator last){
+	void binary_search_tree<T, NodeStorage>::insert(Iterator first, Iterator last){
 		for (; first != last; ++first)
 			insert(*first);
 	}
-	template<class T>
-	void binary_search_tree<T>::print_levelorder(const string& delim, std::ostream& os)const{
+	template<class T, class NodeStorage>
+	void binary_search_tree<T, NodeStorage>::compact(){
+		storage_type fresh;
+		root_ = compact_aux(root_, fresh);
+		if (root_ != 0)
+			root_->parent_ = 0;
+		storage_.swap(fresh);//the old slabs go away with fresh
+	}
+	//copy the subtree of p into fresh in in-order sequence and release the old nodes
+	template<class T, class NodeStorage>
+	typename binary_search_tree<T, NodeStorage>::node *binary_search_tree<T, NodeStorage>::compact_aux(node *p, storage_type& fresh){
+		if (p == 0)
+			return 0;
+		auto left = compact_aux(p->left_, fresh);
+		auto q = fresh.allocate();
+		nodeAllocator::construct(q, *p);
+		q->left_ = left;
+		q->right_ = compact_aux(p->right_, fresh);
+		if (q->left_ != 0)
+			q->left_->parent_ = q;
+		if (q->right_ != 0)
+			q->right_->parent_ = q;
+		nodeAllocator::destroy(p);
+		storage_.deallocate(p);
+		return q;
+	}
+	template<class T, class NodeStorage>
+	void binary_search_tree<T, NodeStorage>::print_levelorder(const string& delim, std::ostream& os)const{
 		auto temp = root_;
 		if (temp != 0){
 			std::deque<node *> q;
@@ -176,66 +233,66 @@ namespace MySTL{
 			}
 		}
 	}
-	template<class T>
-	void binary_search_tree<T>::print_preorder_aux(const string& delim, std::ostream& os, const node *ptr)const{
+	template<class T, class NodeStorage>
+	void binary_search_tree<T, NodeStorage>::print_preorder_aux(const string& delim, std::ostream& os, const node *ptr)const{
 		if (ptr){
 			os << ptr->data_ << delim;
 			print_preorder_aux(delim, os, ptr->left_);
 			print_preorder_aux(delim, os, ptr->right_);
 		}
 	}
-	template<class T>
-	void binary_search_tree<T>::print_preorder(const string& delim, std::ostream& os)const{
+	template<class T, class NodeStorage>
+	void binary_search_tree<T, NodeStorage>::print_preorder(const string& delim, std::ostream& os)const{
 		print_preorder_aux(delim, os, root_);
 	}
-	template<class T>
-	void binary_search_tree<T>::print_inorder_aux(const string& delim, std::ostream& os, const node *ptr)const{
+	template<class T, class NodeStorage>
+	void binary_search_tree<T, NodeStorage>::print_inorder_aux(const string& delim, std::ostream& os, const node *ptr)const{
 		if (ptr){
 			print_inorder_aux(delim, os, ptr->left_);
 			os << ptr->data_ << delim;
 			print_inorder_aux(delim, os, ptr->right_);
 		}
 	}
-	template<class T>
-	void binary_search_tree<T>::print_inorder(const string& delim, std::ostream& os)const{
+	template<class T, class NodeStorage>
+	void binary_search_tree<T, NodeStorage>::print_inorder(const string& delim, std::ostream& os)const{
 		print_inorder_aux(delim, os, root_);
 	}
-	template<class T>
-	void binary_search_tree<T>::print_postorder_aux(const string& delim, std::ostream& os, const node *ptr)const{
+	template<class T, class NodeStorage>
+	void binary_search_tree<T, NodeStorage>::print_postorder_aux(const string& delim, std::ostream& os, const node *ptr)const{
 		if (ptr){
 			print_postorder_aux(delim, os, ptr->left_);
 			print_postorder_aux(delim, os, ptr->right_);
 			os << ptr->data_ << delim;
 		}
 	}
-	template<class T>
-	void binary_search_tree<T>::print_postorder(const string& delim, std::ostream& os)const{
+	template<class T, class NodeStorage>
+	void binary_search_tree<T, NodeStorage>::print_postorder(const string& delim, std::ostream& os)const{
 		print_postorder_aux(delim, os, root_);
 	}
-	template<class T>
-	typename binary_search_tree<T>::const_iterator binary_search_tree<T>::find_min_aux(const node *ptr)const{
+	template<class T, class NodeStorage>
+	typename binary_search_tree<T, NodeStorage>::const_iterator binary_search_tree<T, NodeStorage>::find_min_aux(const node *ptr)const{
 		while (ptr && ptr->left_ != 0){
 			ptr = ptr->left_;
 		}
-		return const_iterator(ptr, this);
+		return const_iterator(ptr);
 	}
-	template<class T>
-	typename binary_search_tree<T>::const_iterator binary_search_tree<T>::find_min()const{
+	template<class T, class NodeStorage>
+	typename binary_search_tree<T, NodeStorage>::const_iterator binary_search_tree<T, NodeStorage>::find_min()const{
 		return find_min_aux(root_);
 	}
-	template<class T>
-	typename binary_search_tree<T>::const_iterator binary_search_tree<T>::find_max_aux(const node *ptr)const{
+	template<class T, class NodeStorage>
+	typename binary_search_tree<T, NodeStorage>::const_iterator binary_search_tree<T, NodeStorage>::find_max_aux(const node *ptr)const{
 		while (ptr && ptr->right_ != 0){
 			ptr = ptr->right_;
 		}
-		return const_iterator(ptr, this);
+		return const_iterator(ptr);
 	}
-	template<class T>
-	typename binary_search_tree<T>::const_iterator binary_search_tree<T>::find_max()const{
+	template<class T, class NodeStorage>
+	typename binary_search_tree<T, NodeStorage>::const_iterator binary_search_tree<T, NodeStorage>::find_max()const{
 		return find_max_aux(root_);
 	}
-	template<class T>
-	typename binary_search_tree<T>::const_iterator binary_search_tree<T>::find_aux(const T& val, const node *ptr)const{
+	template<class T, class NodeStorage>
+	typename binary_search_tree<T, NodeStorage>::const_iterator binary_search_tree<T, NodeStorage>::find_aux(const T& val, const node *ptr)const{
 		while (ptr){
 			if (val == ptr->data_)
 				break;
@@ -244,10 +301,10 @@ namespace MySTL{
 			else
 				ptr = ptr->right_;
 		}
-		return const_iterator(ptr, this);
+		return const_iterator(ptr);
 	}
-	template<class T>
-	typename binary_search_tree<T>::const_iterator binary_search_tree<T>::find(const T& val)const{
+	template<class T, class NodeStorage>
+	typename binary_search_tree<T, NodeStorage>::const_iterator binary_search_tree<T, NodeStorage>::find(const T& val)const{
 		return find_aux(val, root_);
 	}
 }
@@ -0,0 +1,207 @@
+#ifndef _CONCURRENT_ORDERED_SET_IMPL_H_
+#define _CONCURRENT_ORDERED_SET_IMPL_H_
+
+#include <functional>//for hash
+#include <new>
+#include <thread>//for get_id and yield
+
+namespace MySTL{
+	namespace Detail{
+		template<class Node>
+		cos_iter<Node>& cos_iter<Node>::operator = (const cos_iter& it){
+			if (this != &it){
+				if (it.stripe_)
+					it.stripe_->enter();
+				if (stripe_)
+					stripe_->leave();
+				ptr_ = it.ptr_;
+				stripe_ = it.stripe_;
+			}
+			return *this;
+		}
+	}//end of Detail namespace
+
+	template<class Key, class Compare>
+	concurrent_ordered_set<Key, Compare>::concurrent_ordered_set()
+		:level_(1), size_(0), seed_(0x9E3779B97F4A7C15ull), limbo_seen_(0){
+		head_ = new_node(Key(), SKIPLIST_MAX_LEVEL);
+	}
+	template<class Key, class Compare>
+	concurrent_ordered_set<Key, Compare>::~concurrent_ordered_set(){
+		for (node *p = head_, *next; p != 0; p = next){
+			next = p->next_[0].load();
+			delete_node(p);
+		}
+		for (auto it = retired_.begin(); it != retired_.end(); ++it)
+			delete_node(*it);
+		for (auto it = limbo_.begin(); it != limbo_.end(); ++it)
+			delete_node(*it);
+	}
+	template<class Key, class Compare>
+	typename concurrent_ordered_set<Key, Compare>::node *concurrent_ordered_set<Key, Compare>::new_node(const Key& key, size_t level){
+		auto p = nodeAllocator::allocate();
+		new(p) node(key, level);
+		p->next_ = linkAllocator::allocate(level);
+		for (size_t i = 0; i != level; ++i)
+			new(p->next_ + i) std::atomic<node *>(0);
+		return p;
+	}
+	template<class Key, class Compare>
+	void concurrent_ordered_set<Key, Compare>::delete_node(node *p){
+		linkAllocator::deallocate(p->next_, p->level_);
+		nodeAllocator::destroy(p);
+		nodeAllocator::deallocate(p);
+	}
+	//each level holds about a quarter of the nodes of the level below
+	template<class Key, class Compare>
+	size_t concurrent_ordered_set<Key, Compare>::random_level(){
+		seed_ ^= seed_ << 13;
+		seed_ ^= seed_ >> 7;
+		seed_ ^= seed_ << 17;
+		size_t level = 1;
+		for (auto bits = seed_; (bits & 3) == 0 && level != SKIPLIST_MAX_LEVEL; bits >>= 2)
+			++level;
+		return level;
+	}
+	template<class Key, class Compare>
+	Detail::reader_stripe& concurrent_ordered_set<Key, Compare>::stripe()const{
+		unsigned long long h = std::hash<std::thread::id>()(std::this_thread::get_id());
+		h *= 11400714819323198485ull;//thread ids are often aligned, take the high bits
+		return stripes_[(h >> 32) % READER_STRIPES];
+	}
+	//the first node not less than key, the caller must have entered a stripe
+	template<class Key, class Compare>
+	const typename concurrent_ordered_set<Key, Compare>::node *concurrent_ordered_set<Key, Compare>::lower_bound_node(const key_type& key)const{
+		const node *p = head_;
+		for (auto i = level_.load(std::memory_order_acquire); i-- != 0;){
+			auto next = p->next_[i].load(std::memory_order_acquire);
+			while (next != 0 && Compare()(next->key_, key)){
+				p = next;
+				next = p->next_[i].load(std::memory_order_acquire);
+			}
+		}
+		return p->next_[0].load(std::memory_order_acquire);
+	}
+	template<class Key, class Compare>
+	typename concurrent_ordered_set<Key, Compare>::size_type concurrent_ordered_set<Key, Compare>::count(const key_type& key)const{
+		auto& s = stripe();
+		s.enter();
+		auto p = lower_bound_node(key);
+		bool found = p != 0 && !Compare()(key, p->key_);
+		s.leave();
+		return found ? 1 : 0;
+	}
+	template<class Key, class Compare>
+	typename concurrent_ordered_set<Key, Compare>::const_iterator concurrent_ordered_set<Key, Compare>::find(const key_type& key)const{
+		auto it = lower_bound(key);
+		if (it.ptr_ == 0 || Compare()(key, it.ptr_->key_))
+			return cend();
+		return it;
+	}
+	template<class Key, class Compare>
+	typename concurrent_ordered_set<Key, Compare>::const_iterator concurrent_ordered_set<Key, Compare>::lower_bound(const key_type& key)const{
+		const_iterator it(&stripe());
+		it.ptr_ = lower_bound_node(key);
+		return it;
+	}
+	template<class Key, class Compare>
+	typename concurrent_ordered_set<Key, Compare>::const_iterator concurrent_ordered_set<Key, Compare>::cbegin()const{
+		const_iterator it(&stripe());
+		it.ptr_ = head_->next_[0].load(std::memory_order_acquire);
+		return it;
+	}
+	template<class Key, class Compare>
+	template<class Function>
+	Function concurrent_ordered_set<Key, Compare>::for_each(Function fn)const{
+		auto& s = stripe();
+		s.enter();
+		for (auto p = head_->next_[0].load(std::memory_order_acquire); p != 0; p = p->next_[0].load(std::memory_order_acquire))
+			fn(p->key_);
+		s.leave();
+		return fn;
+	}
+	//the last node less than key on every level, the caller must hold writer_
+	template<class Key, class Compare>
+	typename concurrent_ordered_set<Key, Compare>::node *concurrent_ordered_set<Key, Compare>::find_preds(const key_type& key, node **preds){
+		auto p = head_;
+		for (size_t i = SKIPLIST_MAX_LEVEL; i-- != 0;){
+			auto next = p->next_[i].load(std::memory_order_relaxed);
+			while (next != 0 && Compare()(next->key_, key)){
+				p = next;
+				next = p->next_[i].load(std::memory_order_relaxed);
+			}
+			preds[i] = p;
+		}
+		return preds[0]->next_[0].load(std::memory_order_relaxed);
+	}
+	template<class Key, class Compare>
+	bool concurrent_ordered_set<Key, Compare>::insert(const value_type& val){
+		std::lock_guard<std::mutex> lock(writer_);
+		node *preds[SKIPLIST_MAX_LEVEL];
+		auto next = find_preds(val, preds);
+		if (next != 0 && !Compare()(val, next->key_))
+			return false;
+		auto level = random_level();
+		auto p = new_node(val, level);
+		for (size_t i = 0; i != level; ++i)
+			p->next_[i].store(preds[i]->next_[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+		//publish bottom up, a reader that finds p on any level also finds it below
+		for (size_t i = 0; i != level; ++i)
+			preds[i]->next_[i].store(p, std::memory_order_release);
+		if (level > level_.load(std::memory_order_relaxed))
+			level_.store(level, std::memory_order_release);
+		++size_;
+		reclaim();
+		return true;
+	}
+	template<class Key, class Compare>
+	typename concurrent_ordered_set<Key, Compare>::size_type concurrent_ordered_set<Key, Compare>::erase(const key_type& key){
+		std::lock_guard<std::mutex> lock(writer_);
+		node *preds[SKIPLIST_MAX_LEVEL];
+		auto p = find_preds(key, preds);
+		if (p == 0 || Compare()(key, p->key_))
+			return 0;
+		//unlink top down, p keeps its own links so that readers standing on it go on
+		for (auto i = p->level_; i-- != 0;)
+			preds[i]->next_[i].store(p->next_[i].load(std::memory_order_relaxed), std::memory_order_release);
+		--size_;
+		retired_.push_back(p);
+		reclaim();
+		return 1;
+	}
+	//free what the readers allow, and past RETIRE_LIMIT nodes wait for them so
+	//that retired_ can not grow without bound, the caller must hold writer_
+	template<class Key, class Compare>
+	void concurrent_ordered_set<Key, Compare>::reclaim(){
+		reclaim_step();
+		if (Detail::entered_stripes() != 0)//waiting on our own stripe would never end
+			return;
+		while (limbo_.size() + retired_.size() >= RETIRE_LIMIT){
+			std::this_thread::yield();
+			reclaim_step();
+		}
+	}
+	//free limbo_ once every stripe has been seen empty since it was started, then
+	//start a new limbo_ from the nodes retired meanwhile, the caller must hold writer_
+	template<class Key, class Compare>
+	void concurrent_ordered_set<Key, Compare>::reclaim_step(){
+		if (limbo_.empty()){
+			if (retired_.empty())
+				return;
+			limbo_.swap(retired_);
+			limbo_seen_ = 0;
+		}
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		for (size_t i = 0; i != READER_STRIPES; ++i){
+			if (stripes_[i].readers_.load() == 0)
+				limbo_seen_ |= 1u << i;
+		}
+		if (limbo_seen_ != (1u << READER_STRIPES) - 1)
+			return;
+		for (auto it = limbo_.begin(); it != limbo_.end(); ++it)
+			delete_node(*it);
+		limbo_.clear();
+	}
+}
+
+#endif
\ No newline at end of file
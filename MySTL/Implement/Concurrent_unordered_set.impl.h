@@ -0,0 +1,119 @@
+#ifndef _CONCURRENT_UNORDERED_SET_IMPL_H_
+#define _CONCURRENT_UNORDERED_SET_IMPL_H_
+
+#include <thread>//for yield
+
+namespace MySTL{
+	namespace Detail{
+		inline void rw_lock::lock_shared(){
+			for (;;){
+				while (writing_.load())
+					std::this_thread::yield();
+				readers_.fetch_add(1);
+				if (!writing_.load())
+					return;
+				readers_.fetch_sub(1);//a writer came in between, let it go first
+			}
+		}
+		inline void rw_lock::lock(){
+			writer_.lock();
+			writing_.store(true);
+			while (readers_.load() != 0)
+				std::this_thread::yield();
+		}
+		inline void rw_lock::unlock(){
+			writing_.store(false);
+			writer_.unlock();
+		}
+	}//end of Detail namespace
+
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	concurrent_unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::concurrent_unordered_set(size_type bucket_count, size_type shard_count){
+		shard_count_ = 1;
+		shard_shift_ = sizeof(unsigned long long) * 8;
+		while (shard_count_ < shard_count){
+			shard_count_ <<= 1;
+			--shard_shift_;
+		}
+		shards_ = shardAllocator::allocate(shard_count_);
+		for (size_type i = 0; i != shard_count_; ++i)
+			new(shards_ + i) shard(bucket_count / shard_count_);
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	concurrent_unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::~concurrent_unordered_set(){
+		shardAllocator::destroy(shards_, shards_ + shard_count_);
+		shardAllocator::deallocate(shards_, shard_count_);
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	typename concurrent_unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::shard&
+		concurrent_unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::shard_of(const key_type& key)const{
+		if (shard_count_ == 1)
+			return shards_[0];
+		//fibonacci hashing spreads hashes such as the identity std::hash<int> over the high bits
+		unsigned long long h = haser()(key);
+		h *= 11400714819323198485ull;
+		return shards_[h >> shard_shift_];
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	typename concurrent_unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::size_type
+		concurrent_unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::size()const{
+		size_type n = 0;
+		for (size_type i = 0; i != shard_count_; ++i){
+			shards_[i].lock_.lock_shared();
+			n += shards_[i].set_.size();
+			shards_[i].lock_.unlock_shared();
+		}
+		return n;
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	typename concurrent_unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::size_type
+		concurrent_unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::count(const key_type& key)const{
+		auto& s = shard_of(key);
+		s.lock_.lock_shared();
+		auto n = s.set_.count(key);
+		s.lock_.unlock_shared();
+		return n;
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	template<class Function>
+	bool concurrent_unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::find(const key_type& key, Function fn)const{
+		auto& s = shard_of(key);
+		s.lock_.lock_shared();
+		auto it = s.set_.find(key);
+		bool found = (it != s.set_.end());
+		if (found)
+			fn(*it);
+		s.lock_.unlock_shared();
+		return found;
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	bool concurrent_unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::insert(const value_type& val){
+		auto& s = shard_of(val);
+		s.lock_.lock();
+		bool inserted = s.set_.insert(val).second;
+		s.lock_.unlock();
+		return inserted;
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	typename concurrent_unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::size_type
+		concurrent_unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::erase(const key_type& key){
+		auto& s = shard_of(key);
+		s.lock_.lock();
+		auto n = s.set_.erase(key);
+		s.lock_.unlock();
+		return n;
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	template<class Function>
+	Function concurrent_unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::for_each(Function fn)const{
+		for (size_type i = 0; i != shard_count_; ++i){
+			auto& s = shards_[i];
+			s.lock_.lock_shared();
+			for (auto it = s.set_.begin(); it != s.set_.end(); ++it)
+				fn(*it);
+			s.lock_.unlock_shared();
+		}
+		return fn;
+	}
+}
+#endif
\ No newline at end of file
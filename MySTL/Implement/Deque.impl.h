@@ -246,7 +246,7 @@ namespace MySTL{
 	deque<T, Alloc>::deque()
 		:mapSize_(0), map_(0){}
 	template<class T, class Alloc>
-	deque<T, Alloc>::deque(size_type n, const value_type& val = value_type()){
+	deque<T, Alloc>::deque(size_type n, const value_type& val){
 		deque();
 		deque_aux(n, val, typename std::is_integral<size_type>::type());
 	}
@@ -0,0 +1,140 @@
+#ifndef _EYTZINGER_ARRAY_IMPL_H_
+#define _EYTZINGER_ARRAY_IMPL_H_
+
+#include <cstdint>
+
+namespace MySTL{
+	namespace Detail{
+		//the search went right from its answer and then left all the way down: strip the
+		//trailing left turns and the right turn before them, 0 if it never turned right
+		inline size_t eytzinger_answer(size_t k){
+#if defined(__GNUC__)
+			return k >> (__builtin_ctzll(~static_cast<unsigned long long>(k)) + 1);
+#else
+			while (k & 1)
+				k >>= 1;
+			return k >> 1;
+#endif
+		}
+	}
+
+	//room for nodes 1 ... n, slot 0 sits on a cache line boundary
+	template<class T, class Compare>
+	void eytzinger_array<T, Compare>::allocate(size_type n){
+		const size_t align = alignof(T) > CACHE_LINE ? alignof(T) : CACHE_LINE;
+		buffer_ = ::operator new((n + 1) * sizeof(T) + align - 1);
+		tree_ = reinterpret_cast<T *>((reinterpret_cast<uintptr_t>(buffer_) + align - 1) & ~(align - 1));
+		size_ = n;
+	}
+
+	template<class T, class Compare>
+	template<class InputIterator>
+	eytzinger_array<T, Compare>::eytzinger_array(InputIterator first, InputIterator last, value_compare comp)
+		:buffer_(0), tree_(0), size_(0), comp_(comp){
+		vector<T> values, sorted;
+		for (; first != last; ++first)
+			values.push_back(*first);
+		MySTL::sort(values.begin(), values.end(), comp_);
+		for (auto it = values.begin(); it != values.end(); ++it){
+			if (sorted.empty() || comp_(sorted.back(), *it))
+				sorted.push_back(*it);
+		}
+		if (sorted.empty())
+			return;
+		allocate(sorted.size());
+		build(sorted, 0, 1);
+	}
+
+	template<class T, class Compare>
+	eytzinger_array<T, Compare>::eytzinger_array(const eytzinger_array& other)
+		:buffer_(0), tree_(0), size_(0), comp_(other.comp_){
+		if (other.size_ == 0)
+			return;
+		allocate(other.size_);
+		for (size_type k = 1; k <= size_; ++k)
+			MySTL::construct(tree_ + k, other.tree_[k]);
+	}
+
+	template<class T, class Compare>
+	eytzinger_array<T, Compare>::eytzinger_array(eytzinger_array&& other)
+		:buffer_(other.buffer_), tree_(other.tree_), size_(other.size_), comp_(other.comp_){
+		other.buffer_ = 0;
+		other.tree_ = 0;
+		other.size_ = 0;
+	}
+
+	template<class T, class Compare>
+	eytzinger_array<T, Compare>& eytzinger_array<T, Compare>::operator = (eytzinger_array other){
+		swap(other);
+		return *this;
+	}
+
+	template<class T, class Compare>
+	eytzinger_array<T, Compare>::~eytzinger_array(){
+		for (size_type k = 1; k <= size_; ++k)
+			MySTL::destroy(tree_ + k);
+		::operator delete(buffer_);
+	}
+
+	template<class T, class Compare>
+	void eytzinger_array<T, Compare>::swap(eytzinger_array& other){
+		MySTL::swap(buffer_, other.buffer_);
+		MySTL::swap(tree_, other.tree_);
+		MySTL::swap(size_, other.size_);
+		MySTL::swap(comp_, other.comp_);
+	}
+
+	//in order walk of the tree, the i-th sorted value goes to the i-th node visited
+	template<class T, class Compare>
+	typename eytzinger_array<T, Compare>::size_type
+		eytzinger_array<T, Compare>::build(const vector<T>& sorted, size_type i, size_type k){
+		if (k <= size()){
+			i = build(sorted, i, 2 * k);
+			MySTL::construct(tree_ + k, sorted[i++]);
+			i = build(sorted, i, 2 * k + 1);
+		}
+		return i;
+	}
+
+	//the walk goes left while the node may be the answer and right otherwise, without a
+	//branch, it ends below a leaf and the answer is the last node it went left from
+	template<class T, class Compare>
+	template<bool Upper>
+	typename eytzinger_array<T, Compare>::const_iterator
+		eytzinger_array<T, Compare>::search(const value_type& val)const{
+		const T *tree = tree_;
+		const size_type n = size_;
+		value_compare comp = comp_;
+		size_type k = 1;
+		while (k <= n){
+			//the line of the descendants four levels down, past the end it is never read
+			MySTL::prefetch(reinterpret_cast<const void *>(reinterpret_cast<uintptr_t>(tree) + k * PREFETCH_STRIDE * sizeof(T)));
+			const bool right = Upper ? !comp(val, tree[k]) : comp(tree[k], val);
+			k = 2 * k + (right ? 1 : 0);
+		}
+		k = Detail::eytzinger_answer(k);
+		return k == 0 ? end() : tree + k;
+	}
+
+	template<class T, class Compare>
+	typename eytzinger_array<T, Compare>::const_iterator
+		eytzinger_array<T, Compare>::lower_bound(const value_type& val)const{
+		return search<false>(val);
+	}
+
+	template<class T, class Compare>
+	typename eytzinger_array<T, Compare>::const_iterator
+		eytzinger_array<T, Compare>::upper_bound(const value_type& val)const{
+		return search<true>(val);
+	}
+
+	template<class T, class Compare>
+	typename eytzinger_array<T, Compare>::const_iterator
+		eytzinger_array<T, Compare>::find(const value_type& val)const{
+		const_iterator it = lower_bound(val);
+		value_compare comp = comp_;
+		return it != end() && !comp(val, *it) ? it : end();
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include "HashSnapshot.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace MySTL{
+	bool mapped_file::open(const char *path){
+		close();
+#ifdef _WIN32
+		HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0){
+			CloseHandle(file);
+			return false;
+		}
+		HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		CloseHandle(file);// the mapping keeps the file open
+		if (mapping == NULL)
+			return false;
+		void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (view == NULL){
+			CloseHandle(mapping);
+			return false;
+		}
+		handle_ = mapping;
+		data_ = static_cast<const char *>(view);
+		size_ = static_cast<size_t>(size.QuadPart);
+#else
+		int fd = ::open(path, O_RDONLY);
+		if (fd < 0)
+			return false;
+		struct stat st;
+		if (fstat(fd, &st) != 0 || st.st_size == 0){
+			::close(fd);
+			return false;
+		}
+		void *addr = mmap(0, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+		::close(fd);// the mapping stays valid once the descriptor is closed
+		if (addr == MAP_FAILED)
+			return false;
+		data_ = static_cast<const char *>(addr);
+		size_ = static_cast<size_t>(st.st_size);
+#endif
+		return true;
+	}
+
+	void mapped_file::close(){
+		if (data_ == 0)
+			return;
+#ifdef _WIN32
+		UnmapViewOfFile(data_);
+		CloseHandle(handle_);
+#else
+		munmap(const_cast<char *>(data_), size_);
+#endif
+		data_ = 0;
+		size_ = 0;
+		handle_ = 0;
+	}
+}
\ No newline at end of file
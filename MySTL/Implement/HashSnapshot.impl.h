@@ -0,0 +1,136 @@
+#ifndef _HASH_SNAPSHOT_IMPL_H_
+#define _HASH_SNAPSHOT_IMPL_H_
+
+#include <cstdio>
+
+#define SNAPSHOT_MAGIC "MYSTLHS"// 7 chars and the terminating zero fill magic_
+#define SNAPSHOT_VERSION 2
+
+namespace MySTL{
+	namespace Detail{
+		inline bool snapshot_little_endian(){
+			const uint16_t one = 1;
+			return *reinterpret_cast<const uint8_t *>(&one) == 1;
+		}
+		//an empty section is skipped, its buffer may be null
+		inline bool snapshot_write(const void *data, size_t size, size_t count, FILE *file){
+			return count == 0 || fwrite(data, size, count, file) == count;
+		}
+	}
+
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	bool write_snapshot(Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>& set, const char *path){
+		typedef Detail::snapshot_traits<Key> traits;
+		typedef typename traits::entry_type entry_type;
+
+		Detail::snapshot_header header;
+		memset(&header, 0, sizeof(header));
+		memcpy(header.magic_, SNAPSHOT_MAGIC, sizeof(header.magic_));
+		header.version_ = SNAPSHOT_VERSION;
+		header.entry_size_ = sizeof(entry_type);
+		header.policy_id_ = BucketPolicy::id;
+		header.little_endian_ = Detail::snapshot_little_endian() ? 1 : 0;
+		header.size_t_width_ = sizeof(size_t);
+		header.bucket_count_ = BucketPolicy::bucket_count(set.size());
+		header.size_ = set.size();
+
+		//counting sort of the elements by bucket: count, prefix sum, then place
+		size_t bucket_count = (size_t)header.bucket_count_;
+		MySTL::vector<uint64_t> offsets(bucket_count + 1, (uint64_t)0);
+		for (auto it = set.begin(); it != set.end(); ++it)
+			++offsets[BucketPolicy::index(Hash()(*it), bucket_count) + 1];
+		for (size_t i = 0; i != bucket_count; ++i)
+			offsets[i + 1] += offsets[i];
+		MySTL::vector<uint64_t> cursor(offsets);
+		MySTL::vector<entry_type> entries(set.size());
+		MySTL::vector<char> pool;
+		for (auto it = set.begin(); it != set.end(); ++it){
+			auto index = BucketPolicy::index(Hash()(*it), bucket_count);
+			entries[cursor[index]++] = traits::make_entry(*it, pool);
+		}
+		header.pool_size_ = pool.size();
+
+		FILE *file = fopen(path, "wb");
+		if (file == 0)
+			return false;
+		bool ok = Detail::snapshot_write(&header, sizeof(header), 1, file) &&
+			Detail::snapshot_write(offsets.begin(), sizeof(uint64_t), offsets.size(), file) &&
+			Detail::snapshot_write(entries.begin(), sizeof(entry_type), entries.size(), file) &&
+			Detail::snapshot_write(pool.begin(), 1, pool.size(), file);
+		return fclose(file) == 0 && ok;
+	}
+
+	template<class Key, class Hash, class KeyEqual, class BucketPolicy>
+	bool hash_set_snapshot<Key, Hash, KeyEqual, BucketPolicy>::open(const char *path){
+		close();
+		if (!file_.open(path))
+			return false;
+		if (!check(file_.data(), file_.size())){
+			file_.close();
+			return false;
+		}
+		header_ = reinterpret_cast<const Detail::snapshot_header *>(file_.data());
+		offsets_ = reinterpret_cast<const uint64_t *>(header_ + 1);
+		entries_ = reinterpret_cast<const entry_type *>(offsets_ + header_->bucket_count_ + 1);
+		pool_ = reinterpret_cast<const char *>(entries_ + header_->size_);
+		return true;
+	}
+	template<class Key, class Hash, class KeyEqual, class BucketPolicy>
+	bool hash_set_snapshot<Key, Hash, KeyEqual, BucketPolicy>::check(const char *data, size_t size){
+		auto header = reinterpret_cast<const Detail::snapshot_header *>(data);
+		if (size < sizeof(*header) ||
+			memcmp(header->magic_, SNAPSHOT_MAGIC, sizeof(header->magic_)) != 0 ||
+			header->version_ != SNAPSHOT_VERSION ||
+			header->entry_size_ != sizeof(entry_type) ||
+			header->policy_id_ != BucketPolicy::id ||
+			header->little_endian_ != (Detail::snapshot_little_endian() ? 1 : 0) ||
+			header->size_t_width_ != sizeof(size_t) ||
+			header->bucket_count_ == 0)
+			return false;
+		//the sections must fit in the file, every count is compared with what is
+		//left before it is multiplied so that nothing can overflow
+		uint64_t rest = size - sizeof(*header);
+		if (header->bucket_count_ >= rest / sizeof(uint64_t))
+			return false;
+		rest -= (header->bucket_count_ + 1) * sizeof(uint64_t);
+		if (header->size_ > rest / sizeof(entry_type))
+			return false;
+		rest -= header->size_ * sizeof(entry_type);
+		if (header->pool_size_ > rest)
+			return false;
+		//contains trusts the offsets and the entries, so they are all checked here
+		auto offsets = reinterpret_cast<const uint64_t *>(header + 1);
+		auto entries = reinterpret_cast<const entry_type *>(offsets + header->bucket_count_ + 1);
+		if (offsets[0] != 0 || offsets[header->bucket_count_] != header->size_)
+			return false;
+		for (uint64_t i = 0; i != header->bucket_count_; ++i){
+			if (offsets[i] > offsets[i + 1])
+				return false;
+		}
+		for (uint64_t i = 0; i != header->size_; ++i){
+			if (!traits::valid(entries[i], header->pool_size_))
+				return false;
+		}
+		return true;
+	}
+	template<class Key, class Hash, class KeyEqual, class BucketPolicy>
+	void hash_set_snapshot<Key, Hash, KeyEqual, BucketPolicy>::close(){
+		file_.close();
+		header_ = 0;
+		offsets_ = 0;
+		entries_ = 0;
+		pool_ = 0;
+	}
+	template<class Key, class Hash, class KeyEqual, class BucketPolicy>
+	bool hash_set_snapshot<Key, Hash, KeyEqual, BucketPolicy>::contains(const key_type& key)const{
+		if (header_ == 0)
+			return false;
+		auto index = BucketPolicy::index(haser()(key), (size_t)header_->bucket_count_);
+		for (auto i = offsets_[index]; i != offsets_[index + 1]; ++i){
+			if (traits::template equal<key_equal>(entries_[i], pool_, key))
+				return true;
+		}
+		return false;
+	}
+}
+#endif
\ No newline at end of file
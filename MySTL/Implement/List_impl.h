@@ -174,7 +174,7 @@ namespace MySTL{
 	}
 	template<class T>
 	void list<T>::insert(iterator position, size_type n, const value_type& val){
-		insert_aux(position, n, val, typename std::is_integral<InputIterator>::type());
+		insert_aux(position, n, val, std::true_type());
 	}
 	template<class T>
 	template <class InputIterator>
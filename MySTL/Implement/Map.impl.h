@@ -0,0 +1,25 @@
+#ifndef _MAP_IMPL_H_
+#define _MAP_IMPL_H_
+
+namespace MySTL{
+	template<class Key, class T, class Compare, class NodeStorage>
+	typename map<Key, T, Compare, NodeStorage>::mapped_type& map<Key, T, Compare, NodeStorage>::operator[](const key_type& key){
+		//one descent finds the key or inserts it with a default value
+		auto it = tree_.insert(value_type(key, mapped_type())).first;
+		//the tree is ordered by key only, so the mapped value may change in place
+		return const_cast<mapped_type&>(it->second);
+	}
+	template<class Key, class T, class Compare, class NodeStorage>
+	MySTL::pair<typename map<Key, T, Compare, NodeStorage>::const_iterator, bool>
+		map<Key, T, Compare, NodeStorage>::insert(const value_type& val){
+		return tree_.insert(val);
+	}
+	template<class Key, class T, class Compare, class NodeStorage>
+	template<class InputIterator>
+	void map<Key, T, Compare, NodeStorage>::insert(InputIterator first, InputIterator last){
+		for (; first != last; ++first)
+			insert(*first);
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,28 @@
+#ifndef _MULTISET_IMPL_H_
+#define _MULTISET_IMPL_H_
+
+namespace MySTL{
+	template<class T, class Compare, class NodeStorage>
+	typename multiset<T, Compare, NodeStorage>::size_type multiset<T, Compare, NodeStorage>::count(const key_type& key)const{
+		size_type n = 0;
+		auto range = equal_range(key);
+		for (auto it = range.first; it != range.second; ++it)
+			++n;
+		return n;
+	}
+	template<class T, class Compare, class NodeStorage>
+	template<class InputIterator>
+	void multiset<T, Compare, NodeStorage>::insert(InputIterator first, InputIterator last){
+		for (; first != last; ++first)
+			insert(*first);
+	}
+	template<class T, class Compare, class NodeStorage>
+	typename multiset<T, Compare, NodeStorage>::size_type multiset<T, Compare, NodeStorage>::erase(const key_type& key){
+		size_type n = 0;
+		while (tree_.erase(key) != 0)
+			++n;
+		return n;
+	}
+}
+
+#endif
\ No newline at end of file
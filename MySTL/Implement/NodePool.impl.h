@@ -0,0 +1,59 @@
+#ifndef _NODE_POOL_IMPL_H_
+#define _NODE_POOL_IMPL_H_
+
+namespace MySTL{
+	template<class Node>
+	node_pool<Node>::~node_pool(){
+		for (auto it = slabs_.begin(); it != slabs_.end(); ++it)
+			slabAllocator::deallocate(*it, SLAB_NODES);
+	}
+	template<class Node>
+	Node *node_pool<Node>::allocate(){
+		if (free_ != 0){
+			auto p = free_;
+			free_ = free_->next_;
+			return reinterpret_cast<Node *>(p);
+		}
+		if (cur_ == end_){
+			cur_ = slabAllocator::allocate(SLAB_NODES);
+			end_ = cur_ + SLAB_NODES;
+			slabs_.push_back(cur_);
+		}
+		return cur_++;
+	}
+	template<class Node>
+	void node_pool<Node>::deallocate(Node *p){
+		auto f = reinterpret_cast<free_node *>(p);
+		f->next_ = free_;
+		free_ = f;
+	}
+	template<class Node>
+	void node_pool<Node>::swap(node_pool& other){
+		slabs_.swap(other.slabs_);
+		MySTL::swap(cur_, other.cur_);
+		MySTL::swap(end_, other.end_);
+		MySTL::swap(free_, other.free_);
+	}
+	template<class Node>
+	void node_pool<Node>::merge(node_pool& other){
+		if (&other == this)
+			return;
+		for (auto it = other.slabs_.begin(); it != other.slabs_.end(); ++it)
+			slabs_.push_back(*it);
+		vector<Node *>().swap(other.slabs_);
+		if (cur_ == end_){//keep whichever unused tail is left
+			MySTL::swap(cur_, other.cur_);
+			MySTL::swap(end_, other.end_);
+		}
+		for (; other.cur_ != other.end_; ++other.cur_)
+			deallocate(other.cur_);
+		while (other.free_ != 0){
+			auto p = other.free_;
+			other.free_ = p->next_;
+			deallocate(reinterpret_cast<Node *>(p));
+		}
+		other.cur_ = other.end_ = 0;
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,384 @@
+#ifndef _PARALLEL_ALGORITHM_IMPL_H_
+#define _PARALLEL_ALGORITHM_IMPL_H_
+
+namespace MySTL{
+	namespace Detail{
+		//a chunk should cost ten times handing a task to a worker (about 2.5us in
+		//bench/ParallelBench.cpp), cheap linear algorithms take 0.5-1ns an item
+		const ptrdiff_t PARALLEL_SORT_GRAIN = 1 << 14;//smallest range split into tasks, ~40ns an item
+		const size_t PARALLEL_SORT_TASKS = 16;//tasks per thread, for load balance
+
+		const ptrdiff_t PARALLEL_GRAIN = 1 << 16;//smallest chunk of a linear algorithm worth a task
+		const ptrdiff_t PARALLEL_COPY_GRAIN = 1 << 17;//fill and copy are bound by memory, not by the cpu
+		const size_t PARALLEL_CHUNKS = 4;//chunks per thread, for load balance
+		const ptrdiff_t PARALLEL_FIND_BLOCK = 1 << 10;//find_if looks for a stop between blocks
+
+		//number of chunks to cut n items into, 1 keeps the work on the calling thread
+		inline size_t parallel_chunk_count(thread_pool& pool, ptrdiff_t n, ptrdiff_t grain){
+			if (pool.size() == 0)
+				return 1;
+			const ptrdiff_t most = n / grain;
+			const size_t chunks = (pool.size() + 1) * PARALLEL_CHUNKS;
+			if (most < static_cast<ptrdiff_t>(chunks))
+				return most > 1 ? static_cast<size_t>(most) : 1;
+			return chunks;
+		}
+
+		//func(i, begin, end) for the i-th of the chunks of [0, n), the first chunk runs
+		//on the calling thread
+		template<class Function>
+		void parallel_for_chunks(thread_pool& pool, ptrdiff_t n, size_t chunks, Function func){
+			const ptrdiff_t count = static_cast<ptrdiff_t>(chunks);
+			if (count == 1)
+				return func(0, 0, n);
+			task_group group(pool);
+			for (ptrdiff_t i = 1; i != count; ++i){
+				const ptrdiff_t begin = n / count * i + MySTL::min(i, n % count);
+				const ptrdiff_t end = begin + n / count + (i < n % count ? 1 : 0);
+				group.run([=, &func]{ func(static_cast<size_t>(i), begin, end); });
+			}
+			func(0, 0, n / count + (n % count != 0 ? 1 : 0));
+			group.wait();
+		}
+
+		//partition like sort and fork the left part, the right part is kept on this thread
+		template<class RandomIterator, class BinaryPredicate>
+		void parallel_sort_aux(RandomIterator first, RandomIterator last, BinaryPredicate pred,
+			ptrdiff_t grain, int bad_allowed, bool leftmost, task_group& group){
+			typedef typename iterator_traits<RandomIterator>::value_type value_type;
+			const bool branchless = branchless_partition<value_type, BinaryPredicate>::value;
+			while (last - first > grain){
+				auto len = last - first;
+				choose_pivot(first, last, pred);
+				if (!leftmost && !pred(*(first - 1), *first)){//keys equal to the pivot are in place
+					first = partition_left(first, last, pred) + 1;
+					continue;
+				}
+				auto pivot_pos = partition_right<branchless>(first, last, pred).first;
+				if ((pivot_pos - first < len / 8 || last - pivot_pos - 1 < len / 8) && --bad_allowed == 0)
+					break;//leave the bad pattern to sort
+				group.run([=, &group]{
+					parallel_sort_aux(first, pivot_pos, pred, grain, bad_allowed, leftmost, group);
+				});
+				first = pivot_pos + 1;
+				leftmost = false;
+			}
+			MySTL::sort(first, last, pred);
+		}
+	}
+
+	template<class ForwardIterator, class Compare>
+	ForwardIterator min_element(const execution::sequenced_policy&, ForwardIterator first, ForwardIterator last, Compare comp){
+		return MySTL::min_element(first, last, comp);
+	}
+
+	template<class ForwardIterator>
+	ForwardIterator min_element(const execution::sequenced_policy&, ForwardIterator first, ForwardIterator last){
+		return MySTL::min_element(first, last);
+	}
+
+	template<class RandomIterator, class Compare>
+	RandomIterator min_element(const execution::parallel_policy& policy, RandomIterator first, RandomIterator last, Compare comp){
+		thread_pool& pool = policy.pool();
+		const ptrdiff_t n = last - first;
+		const size_t chunks = Detail::parallel_chunk_count(pool, n, Detail::PARALLEL_GRAIN);
+		std::vector<RandomIterator> smallest(chunks);
+		Detail::parallel_for_chunks(pool, n, chunks, [&](size_t i, ptrdiff_t begin, ptrdiff_t end){
+			smallest[i] = MySTL::min_element(first + begin, first + end, comp);
+		});
+		RandomIterator result = smallest[0];
+		for (size_t i = 1; i != chunks; ++i){//the earlier chunk wins a tie
+			if (comp(*smallest[i], *result))
+				result = smallest[i];
+		}
+		return result;
+	}
+
+	template<class RandomIterator>
+	RandomIterator min_element(const execution::parallel_policy& policy, RandomIterator first, RandomIterator last){
+		return MySTL::min_element(policy, first, last, less<typename iterator_traits<RandomIterator>::value_type>());
+	}
+
+	template<class ForwardIterator, class Compare>
+	ForwardIterator max_element(const execution::sequenced_policy&, ForwardIterator first, ForwardIterator last, Compare comp){
+		return MySTL::max_element(first, last, comp);
+	}
+
+	template<class ForwardIterator>
+	ForwardIterator max_element(const execution::sequenced_policy&, ForwardIterator first, ForwardIterator last){
+		return MySTL::max_element(first, last);
+	}
+
+	template<class RandomIterator, class Compare>
+	RandomIterator max_element(const execution::parallel_policy& policy, RandomIterator first, RandomIterator last, Compare comp){
+		thread_pool& pool = policy.pool();
+		const ptrdiff_t n = last - first;
+		const size_t chunks = Detail::parallel_chunk_count(pool, n, Detail::PARALLEL_GRAIN);
+		std::vector<RandomIterator> largest(chunks);
+		Detail::parallel_for_chunks(pool, n, chunks, [&](size_t i, ptrdiff_t begin, ptrdiff_t end){
+			largest[i] = MySTL::max_element(first + begin, first + end, comp);
+		});
+		RandomIterator result = largest[0];
+		for (size_t i = 1; i != chunks; ++i){
+			if (comp(*result, *largest[i]))
+				result = largest[i];
+		}
+		return result;
+	}
+
+	template<class RandomIterator>
+	RandomIterator max_element(const execution::parallel_policy& policy, RandomIterator first, RandomIterator last){
+		return MySTL::max_element(policy, first, last, less<typename iterator_traits<RandomIterator>::value_type>());
+	}
+
+	template<class InputIterator, class T, class BinaryOperation>
+	T reduce(const execution::sequenced_policy&, InputIterator first, InputIterator last, T init, BinaryOperation op){
+		return MySTL::reduce(first, last, init, op);
+	}
+
+	template<class InputIterator, class T>
+	T reduce(const execution::sequenced_policy&, InputIterator first, InputIterator last, T init){
+		return MySTL::reduce(first, last, init);
+	}
+
+	template<class InputIterator>
+	typename iterator_traits<InputIterator>::value_type
+		reduce(const execution::sequenced_policy&, InputIterator first, InputIterator last){
+		return MySTL::reduce(first, last);
+	}
+
+	//every chunk is reduced from its first item, init joins the partial results
+	template<class RandomIterator, class T, class BinaryOperation>
+	T reduce(const execution::parallel_policy& policy, RandomIterator first, RandomIterator last, T init, BinaryOperation op){
+		thread_pool& pool = policy.pool();
+		const ptrdiff_t n = last - first;
+		const size_t chunks = Detail::parallel_chunk_count(pool, n, Detail::PARALLEL_GRAIN);
+		if (chunks == 1)
+			return MySTL::reduce(first, last, init, op);
+		std::vector<T> sums(chunks, init);
+		Detail::parallel_for_chunks(pool, n, chunks, [&](size_t i, ptrdiff_t begin, ptrdiff_t end){
+			sums[i] = MySTL::reduce(first + begin + 1, first + end, static_cast<T>(first[begin]), op);
+		});
+		for (size_t i = 0; i != chunks; ++i)
+			init = op(init, sums[i]);
+		return init;
+	}
+
+	template<class RandomIterator, class T>
+	T reduce(const execution::parallel_policy& policy, RandomIterator first, RandomIterator last, T init){
+		thread_pool& pool = policy.pool();
+		const ptrdiff_t n = last - first;
+		const size_t chunks = Detail::parallel_chunk_count(pool, n, Detail::PARALLEL_GRAIN);
+		if (chunks == 1)
+			return MySTL::reduce(first, last, init);
+		std::vector<T> sums(chunks, init);
+		Detail::parallel_for_chunks(pool, n, chunks, [&](size_t i, ptrdiff_t begin, ptrdiff_t end){
+			sums[i] = MySTL::reduce(first + begin + 1, first + end, static_cast<T>(first[begin]));
+		});
+		for (size_t i = 0; i != chunks; ++i)
+			init = init + sums[i];
+		return init;
+	}
+
+	template<class RandomIterator>
+	typename iterator_traits<RandomIterator>::value_type
+		reduce(const execution::parallel_policy& policy, RandomIterator first, RandomIterator last){
+		return MySTL::reduce(policy, first, last, typename iterator_traits<RandomIterator>::value_type());
+	}
+
+	template<class InputIterator, class OutputIterator, class UnaryOperation>
+	OutputIterator transform(const execution::sequenced_policy&, InputIterator first, InputIterator last,
+		OutputIterator result, UnaryOperation op){
+		return MySTL::transform(first, last, result, op);
+	}
+
+	template<class InputIterator1, class InputIterator2, class OutputIterator, class BinaryOperation>
+	OutputIterator transform(const execution::sequenced_policy&, InputIterator1 first1, InputIterator1 last1,
+		InputIterator2 first2, OutputIterator result, BinaryOperation op){
+		return MySTL::transform(first1, last1, first2, result, op);
+	}
+
+	template<class RandomIterator, class OutputIterator, class UnaryOperation>
+	OutputIterator transform(const execution::parallel_policy& policy, RandomIterator first, RandomIterator last,
+		OutputIterator result, UnaryOperation op){
+		thread_pool& pool = policy.pool();
+		const ptrdiff_t n = last - first;
+		Detail::parallel_for_chunks(pool, n, Detail::parallel_chunk_count(pool, n, Detail::PARALLEL_GRAIN),
+			[&](size_t, ptrdiff_t begin, ptrdiff_t end){
+			MySTL::transform(first + begin, first + end, result + begin, op);
+		});
+		return result + n;
+	}
+
+	template<class RandomIterator1, class RandomIterator2, class OutputIterator, class BinaryOperation>
+	OutputIterator transform(const execution::parallel_policy& policy, RandomIterator1 first1, RandomIterator1 last1,
+		RandomIterator2 first2, OutputIterator result, BinaryOperation op){
+		thread_pool& pool = policy.pool();
+		const ptrdiff_t n = last1 - first1;
+		Detail::parallel_for_chunks(pool, n, Detail::parallel_chunk_count(pool, n, Detail::PARALLEL_GRAIN),
+			[&](size_t, ptrdiff_t begin, ptrdiff_t end){
+			MySTL::transform(first1 + begin, first1 + end, first2 + begin, result + begin, op);
+		});
+		return result + n;
+	}
+
+	template<class InputIterator, class Function>
+	void for_each(const execution::sequenced_policy&, InputIterator first, InputIterator last, Function fn){
+		MySTL::for_each(first, last, fn);
+	}
+
+	template<class RandomIterator, class Function>
+	void for_each(const execution::parallel_policy& policy, RandomIterator first, RandomIterator last, Function fn){
+		thread_pool& pool = policy.pool();
+		const ptrdiff_t n = last - first;
+		Detail::parallel_for_chunks(pool, n, Detail::parallel_chunk_count(pool, n, Detail::PARALLEL_GRAIN),
+			[&](size_t, ptrdiff_t begin, ptrdiff_t end){
+			MySTL::for_each(first + begin, first + end, fn);
+		});
+	}
+
+	template<class InputIterator, class UnaryPredicate>
+	InputIterator find_if(const execution::sequenced_policy&, InputIterator first, InputIterator last, UnaryPredicate pred){
+		return MySTL::find_if(first, last, pred);
+	}
+
+	template<class RandomIterator, class UnaryPredicate>
+	RandomIterator find_if(const execution::parallel_policy& policy, RandomIterator first, RandomIterator last, UnaryPredicate pred){
+		thread_pool& pool = policy.pool();
+		const ptrdiff_t n = last - first;
+		std::atomic<ptrdiff_t> found(n);//least index found so far
+		Detail::parallel_for_chunks(pool, n, Detail::parallel_chunk_count(pool, n, Detail::PARALLEL_GRAIN),
+			[&](size_t, ptrdiff_t begin, ptrdiff_t end){
+			for (; begin < end && begin < found.load(std::memory_order_relaxed); begin += Detail::PARALLEL_FIND_BLOCK){
+				const ptrdiff_t block_end = MySTL::min(begin + Detail::PARALLEL_FIND_BLOCK, end);
+				const ptrdiff_t i = MySTL::find_if(first + begin, first + block_end, pred) - first;
+				if (i != block_end){
+					ptrdiff_t least = found.load(std::memory_order_relaxed);
+					while (i < least && !found.compare_exchange_weak(least, i, std::memory_order_relaxed)){}
+					return;
+				}
+			}
+		});
+		return first + found.load(std::memory_order_relaxed);
+	}
+
+	template<class InputIterator, class UnaryPredicate>
+	typename iterator_traits<InputIterator>::difference_type
+		count_if(const execution::sequenced_policy&, InputIterator first, InputIterator last, UnaryPredicate pred){
+		return MySTL::count_if(first, last, pred);
+	}
+
+	template<class RandomIterator, class UnaryPredicate>
+	typename iterator_traits<RandomIterator>::difference_type
+		count_if(const execution::parallel_policy& policy, RandomIterator first, RandomIterator last, UnaryPredicate pred){
+		typedef typename iterator_traits<RandomIterator>::difference_type difference_type;
+		thread_pool& pool = policy.pool();
+		const ptrdiff_t n = last - first;
+		const size_t chunks = Detail::parallel_chunk_count(pool, n, Detail::PARALLEL_GRAIN);
+		std::vector<difference_type> counts(chunks);
+		Detail::parallel_for_chunks(pool, n, chunks, [&](size_t i, ptrdiff_t begin, ptrdiff_t end){
+			counts[i] = MySTL::count_if(first + begin, first + end, pred);
+		});
+		difference_type count = 0;
+		for (size_t i = 0; i != chunks; ++i)
+			count += counts[i];
+		return count;
+	}
+
+	template<class ForwardIterator, class T>
+	void fill(const execution::sequenced_policy&, ForwardIterator first, ForwardIterator last, const T& value){
+		MySTL::fill(first, last, value);
+	}
+
+	template<class RandomIterator, class T>
+	void fill(const execution::parallel_policy& policy, RandomIterator first, RandomIterator last, const T& value){
+		thread_pool& pool = policy.pool();
+		const ptrdiff_t n = last - first;
+		Detail::parallel_for_chunks(pool, n, Detail::parallel_chunk_count(pool, n, Detail::PARALLEL_COPY_GRAIN),
+			[&](size_t, ptrdiff_t begin, ptrdiff_t end){
+			MySTL::fill(first + begin, first + end, value);
+		});
+	}
+
+	template<class InputIterator, class OutputIterator>
+	OutputIterator copy(const execution::sequenced_policy&, InputIterator first, InputIterator last, OutputIterator result){
+		return MySTL::copy(first, last, result);
+	}
+
+	template<class RandomIterator, class OutputIterator>
+	OutputIterator copy(const execution::parallel_policy& policy, RandomIterator first, RandomIterator last, OutputIterator result){
+		thread_pool& pool = policy.pool();
+		const ptrdiff_t n = last - first;
+		Detail::parallel_for_chunks(pool, n, Detail::parallel_chunk_count(pool, n, Detail::PARALLEL_COPY_GRAIN),
+			[&](size_t, ptrdiff_t begin, ptrdiff_t end){
+			MySTL::copy(first + begin, first + end, result + begin);
+		});
+		return result + n;
+	}
+
+	template<class ForwardIterator, class Generator>
+	void generate(const execution::sequenced_policy&, ForwardIterator first, ForwardIterator last, Generator gen){
+		MySTL::generate(first, last, gen);
+	}
+
+	template<class RandomIterator, class Generator>
+	void generate(const execution::parallel_policy& policy, RandomIterator first, RandomIterator last, Generator gen){
+		thread_pool& pool = policy.pool();
+		const ptrdiff_t n = last - first;
+		Detail::parallel_for_chunks(pool, n, Detail::parallel_chunk_count(pool, n, Detail::PARALLEL_GRAIN),
+			[&](size_t, ptrdiff_t begin, ptrdiff_t end){
+			MySTL::generate(first + begin, first + end, gen);
+		});
+	}
+
+	template<class RandomIterator, class BinaryPredicate>
+	void parallel_sort(RandomIterator first, RandomIterator last, BinaryPredicate pred, thread_pool& pool){
+		auto len = last - first;
+		ptrdiff_t grain = len / static_cast<ptrdiff_t>((pool.size() + 1) * Detail::PARALLEL_SORT_TASKS);
+		if (grain < Detail::PARALLEL_SORT_GRAIN)
+			grain = Detail::PARALLEL_SORT_GRAIN;
+		if (pool.size() == 0 || len <= grain)
+			return MySTL::sort(first, last, pred);
+		int bad_allowed = 0;
+		for (auto n = len; n > 1; n >>= 1)
+			++bad_allowed;
+		task_group group(pool);
+		Detail::parallel_sort_aux(first, last, pred, grain, bad_allowed, true, group);
+		group.wait();
+	}
+
+	template<class RandomIterator, class BinaryPredicate>
+	void parallel_sort(RandomIterator first, RandomIterator last, BinaryPredicate pred, size_t threads){
+		if (threads == 0)
+			return MySTL::parallel_sort(first, last, pred, thread_pool::default_pool());
+		thread_pool pool(threads - 1);
+		MySTL::parallel_sort(first, last, pred, pool);
+	}
+
+	template<class RandomIterator>
+	void parallel_sort(RandomIterator first, RandomIterator last){
+		MySTL::parallel_sort(first, last, less<typename iterator_traits<RandomIterator>::value_type>(), thread_pool::default_pool());
+	}
+
+	template<class RandomIterator, class BinaryPredicate>
+	void sort(const execution::sequenced_policy&, RandomIterator first, RandomIterator last, BinaryPredicate pred){
+		MySTL::sort(first, last, pred);
+	}
+
+	template<class RandomIterator>
+	void sort(const execution::sequenced_policy&, RandomIterator first, RandomIterator last){
+		MySTL::sort(first, last);
+	}
+
+	template<class RandomIterator, class BinaryPredicate>
+	void sort(const execution::parallel_policy& policy, RandomIterator first, RandomIterator last, BinaryPredicate pred){
+		MySTL::parallel_sort(first, last, pred, policy.pool());
+	}
+
+	template<class RandomIterator>
+	void sort(const execution::parallel_policy& policy, RandomIterator first, RandomIterator last){
+		MySTL::parallel_sort(first, last, less<typename iterator_traits<RandomIterator>::value_type>(), policy.pool());
+	}
+}
+
+#endif
\ No newline at end of file
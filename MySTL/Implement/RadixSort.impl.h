@@ -0,0 +1,122 @@
+#ifndef _RADIX_SORT_IMPL_H_
+#define _RADIX_SORT_IMPL_H_
+
+namespace MySTL{
+	namespace Detail{
+		const size_t RADIX_SORT_THRESHOLD = 64;//shorter ranges are insertion sorted, which is stable too
+		const size_t MSD_RADIX_SORT_THRESHOLD = 32;
+
+		//move [first, last) to result, each item to the next free slot of its digit
+		template<class Traits, class InputIterator, class OutputIterator, class KeyOfValue>
+		void radix_scatter(InputIterator first, InputIterator last, OutputIterator result,
+			size_t *offsets, unsigned shift, KeyOfValue key_of){
+			for (; first != last; ++first){
+				auto digit = (Traits::encode(key_of(*first)) >> shift) & 0xff;
+				*(result + offsets[digit]++) = std::move(*first);
+			}
+		}
+
+		//0 for the end of the string, the char + 1 otherwise
+		template<class String>
+		size_t char_at(const String& str, size_t depth){
+			return depth < str.size() ? static_cast<unsigned char>(str[depth]) + 1 : 0;
+		}
+	}
+
+	template<class RandomIterator>
+	void radix_sort(RandomIterator first, RandomIterator last){
+		typedef typename iterator_traits<RandomIterator>::value_type value_type;
+		MySTL::radix_sort(first, last, identity<value_type>());
+	}
+
+	template<class RandomIterator, class KeyOfValue>
+	void radix_sort(RandomIterator first, RandomIterator last, KeyOfValue key_of){
+		typedef typename iterator_traits<RandomIterator>::value_type value_type;
+		typedef typename std::decay<decltype(key_of(*first))>::type key_type;
+		typedef Detail::radix_key<key_type> traits;
+		const size_t n = last - first;
+		if (n < Detail::RADIX_SORT_THRESHOLD){
+			insertion_sort(first, last, Detail::radix_less<KeyOfValue, traits>(key_of));
+			return;
+		}
+		const int digits = sizeof(typename traits::type);
+		size_t counts[digits][256] = {};//all the histograms in one pass
+		for (auto it = first; it != last; ++it){
+			auto key = traits::encode(key_of(*it));
+			for (int d = 0; d != digits; ++d)
+				++counts[d][(key >> (d * 8)) & 0xff];
+		}
+		const auto first_key = traits::encode(key_of(*first));
+		MySTL::vector<value_type> buffer(n);
+		bool in_buffer = false;
+		for (int d = 0; d != digits; ++d){
+			const unsigned shift = d * 8;
+			if (counts[d][(first_key >> shift) & 0xff] == n)//every item has the same digit
+				continue;
+			size_t offsets[256];
+			size_t sum = 0;
+			for (int i = 0; i != 256; ++i){
+				offsets[i] = sum;
+				sum += counts[d][i];
+			}
+			if (in_buffer)
+				Detail::radix_scatter<traits>(buffer.begin(), buffer.end(), first, offsets, shift, key_of);
+			else
+				Detail::radix_scatter<traits>(first, last, buffer.begin(), offsets, shift, key_of);
+			in_buffer = !in_buffer;
+		}
+		if (in_buffer){
+			auto it = first;
+			for (auto p = buffer.begin(); p != buffer.end(); ++p, ++it)
+				*it = std::move(*p);
+		}
+	}
+
+	template<class RandomIterator>
+	void msd_radix_sort(RandomIterator first, RandomIterator last){
+		typedef typename iterator_traits<RandomIterator>::value_type value_type;
+		const size_t n = last - first;
+		if (n < 2)
+			return;
+		MySTL::vector<value_type> buffer(n);
+		MySTL::vector<Detail::msd_range> pending;//an explicit stack, long common prefixes go deep
+		pending.push_back(Detail::msd_range(0, n, 0));
+		while (!pending.empty()){
+			auto range = pending.back();
+			pending.pop_back();
+			auto lo = first + range.lo_, hi = first + range.hi_;
+			if (range.hi_ - range.lo_ < Detail::MSD_RADIX_SORT_THRESHOLD){
+				MySTL::sort(lo, hi, Detail::string_less_from(range.depth_));
+				continue;
+			}
+			size_t counts[257] = {};
+			for (auto it = lo; it != hi; ++it)
+				++counts[Detail::char_at(*it, range.depth_)];
+			const size_t first_bucket = Detail::char_at(*lo, range.depth_);
+			if (counts[first_bucket] == range.hi_ - range.lo_){//one bucket, nothing to move
+				if (first_bucket != 0)
+					pending.push_back(Detail::msd_range(range.lo_, range.hi_, range.depth_ + 1));
+				continue;
+			}
+			size_t offsets[257];
+			size_t sum = range.lo_;
+			for (int i = 0; i != 257; ++i){
+				offsets[i] = sum;
+				sum += counts[i];
+			}
+			for (auto it = lo; it != hi; ++it)
+				buffer[offsets[Detail::char_at(*it, range.depth_)]++] = std::move(*it);
+			for (size_t i = range.lo_; i != range.hi_; ++i)
+				*(first + i) = std::move(buffer[i]);
+			//the strings that ended are equal and done, the others go one char deeper
+			size_t start = range.lo_ + counts[0];
+			for (int i = 1; i != 257; ++i){
+				if (counts[i] > 1)
+					pending.push_back(Detail::msd_range(start, start + counts[i], range.depth_ + 1));
+				start += counts[i];
+			}
+		}
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,567 @@
+#include "Simd.h"
+
+#if MYSTL_SIMD_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__)
+#define MYSTL_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define MYSTL_TARGET_AVX2
+#endif
+
+namespace MySTL{
+	namespace{
+		template<class T>
+		size_t find_scalar(const T *first, size_t n, T val){
+			size_t i = 0;
+			while (i != n && first[i] != val)
+				++i;
+			return i;
+		}
+		template<class T>
+		size_t count_scalar(const T *first, size_t n, T val){
+			size_t count = 0;
+			for (size_t i = 0; i != n; ++i)
+				count += first[i] == val;
+			return count;
+		}
+		size_t mismatch_scalar(const unsigned char *a, const unsigned char *b, size_t bytes){
+			size_t i = 0;
+			while (i != bytes && a[i] == b[i])
+				++i;
+			return i;
+		}
+
+		//integers are summed in the unsigned type of their width, whose adds wrap
+		//instead of overflowing whatever the order they are taken in
+		template<class T>
+		struct sum_type{ typedef T type; };
+		template<>
+		struct sum_type<int32_t>{ typedef uint32_t type; };
+		template<>
+		struct sum_type<int64_t>{ typedef uint64_t type; };
+
+		template<class T>
+		typename sum_type<T>::type sum_scalar(const T *first, size_t n){
+			typename sum_type<T>::type sum = 0;
+			for (size_t i = 0; i != n; ++i)
+				sum += static_cast<typename sum_type<T>::type>(first[i]);
+			return sum;
+		}
+		//index of the first least (or greatest) item, NO_INDEX if a NaN is met
+		template<bool Greatest, class T>
+		size_t extreme_scalar(const T *first, size_t n){
+			size_t best = 0;
+			for (size_t i = 0; i != n; ++i){
+				if (first[i] != first[i])
+					return Detail::SIMD_NO_INDEX;
+				if (Greatest ? first[best] < first[i] : first[i] < first[best])
+					best = i;
+			}
+			return best;
+		}
+		//the lanes have reduced to val, find it
+		template<bool Greatest, class T>
+		size_t extreme_finish(const T *first, size_t n, const T *lanes, size_t count, size_t i){
+			T val = lanes[0];
+			for (size_t l = 1; l != count; ++l)
+				val = (Greatest ? val < lanes[l] : lanes[l] < val) ? lanes[l] : val;
+			for (; i != n; ++i){
+				if (first[i] != first[i])
+					return Detail::SIMD_NO_INDEX;
+				val = (Greatest ? val < first[i] : first[i] < val) ? first[i] : val;
+			}
+			return find_scalar(first, n, val);
+		}
+
+#if MYSTL_SIMD_X86
+		simd_level detect_simd_level(){
+#if defined(__GNUC__)
+			__builtin_cpu_init();
+			return __builtin_cpu_supports("avx2") ? SIMD_AVX2 : SIMD_SSE2;
+#elif defined(_MSC_VER)
+			int info[4];
+			__cpuid(info, 0);
+			if (info[0] < 7)
+				return SIMD_SSE2;
+			__cpuid(info, 1);
+			const bool avx = (info[2] & (1 << 28)) != 0, osxsave = (info[2] & (1 << 27)) != 0;
+			if (!avx || !osxsave || (_xgetbv(0) & 6) != 6)//the os must save the ymm registers
+				return SIMD_SSE2;
+			__cpuidex(info, 7, 0);
+			return (info[1] & (1 << 5)) != 0 ? SIMD_AVX2 : SIMD_SSE2;
+#else
+			return SIMD_SSE2;
+#endif
+		}
+
+		inline unsigned lowest_bit(unsigned mask){
+#if defined(__GNUC__)
+			return __builtin_ctz(mask);
+#else
+			unsigned long index;
+			_BitScanForward(&index, mask);
+			return index;
+#endif
+		}
+		inline unsigned popcount(unsigned x){
+			x = x - ((x >> 1) & 0x55555555u);
+			x = (x & 0x33333333u) + ((x >> 2) & 0x33333333u);
+			return (((x + (x >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24;
+		}
+
+		// byte masks of the lanes equal to val, a lane of Width bytes sets Width bits
+		template<size_t Width>
+		struct sse2_lanes;
+		template<>
+		struct sse2_lanes<1>{
+			static __m128i set1(uint64_t v){ return _mm_set1_epi8(static_cast<char>(v)); }
+			static __m128i cmpeq(__m128i a, __m128i b){ return _mm_cmpeq_epi8(a, b); }
+		};
+		template<>
+		struct sse2_lanes<2>{
+			static __m128i set1(uint64_t v){ return _mm_set1_epi16(static_cast<short>(v)); }
+			static __m128i cmpeq(__m128i a, __m128i b){ return _mm_cmpeq_epi16(a, b); }
+		};
+		template<>
+		struct sse2_lanes<4>{
+			static __m128i set1(uint64_t v){ return _mm_set1_epi32(static_cast<int>(v)); }
+			static __m128i cmpeq(__m128i a, __m128i b){ return _mm_cmpeq_epi32(a, b); }
+		};
+		template<>
+		struct sse2_lanes<8>{
+			static __m128i set1(uint64_t v){
+				const int lo = static_cast<int>(v), hi = static_cast<int>(v >> 32);
+				return _mm_set_epi32(hi, lo, hi, lo);
+			}
+			static __m128i cmpeq(__m128i a, __m128i b){//sse2 has no 64-bit compare, both halves must match
+				const __m128i eq = _mm_cmpeq_epi32(a, b);
+				return _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+			}
+		};
+
+		template<size_t Width>
+		struct avx2_lanes;
+		template<>
+		struct avx2_lanes<1>{
+			MYSTL_TARGET_AVX2 static __m256i set1(uint64_t v){ return _mm256_set1_epi8(static_cast<char>(v)); }
+			MYSTL_TARGET_AVX2 static __m256i cmpeq(__m256i a, __m256i b){ return _mm256_cmpeq_epi8(a, b); }
+		};
+		template<>
+		struct avx2_lanes<2>{
+			MYSTL_TARGET_AVX2 static __m256i set1(uint64_t v){ return _mm256_set1_epi16(static_cast<short>(v)); }
+			MYSTL_TARGET_AVX2 static __m256i cmpeq(__m256i a, __m256i b){ return _mm256_cmpeq_epi16(a, b); }
+		};
+		template<>
+		struct avx2_lanes<4>{
+			MYSTL_TARGET_AVX2 static __m256i set1(uint64_t v){ return _mm256_set1_epi32(static_cast<int>(v)); }
+			MYSTL_TARGET_AVX2 static __m256i cmpeq(__m256i a, __m256i b){ return _mm256_cmpeq_epi32(a, b); }
+		};
+		template<>
+		struct avx2_lanes<8>{
+			MYSTL_TARGET_AVX2 static __m256i set1(uint64_t v){ return _mm256_set1_epi64x(static_cast<long long>(v)); }
+			MYSTL_TARGET_AVX2 static __m256i cmpeq(__m256i a, __m256i b){ return _mm256_cmpeq_epi64(a, b); }
+		};
+
+		//4 vectors are compared per step, the masks are only looked at when one is set
+		template<class T>
+		size_t find_sse2(const T *first, size_t n, T val){
+			typedef sse2_lanes<sizeof(T)> lanes;
+			const size_t step = 16 / sizeof(T);
+			const __m128i needle = lanes::set1(val);
+			size_t i = 0;
+			for (; i + 4 * step <= n; i += 4 * step){
+				const __m128i *p = reinterpret_cast<const __m128i *>(first + i);
+				const __m128i a = lanes::cmpeq(_mm_loadu_si128(p), needle);
+				const __m128i b = lanes::cmpeq(_mm_loadu_si128(p + 1), needle);
+				const __m128i c = lanes::cmpeq(_mm_loadu_si128(p + 2), needle);
+				const __m128i d = lanes::cmpeq(_mm_loadu_si128(p + 3), needle);
+				if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d))) != 0)
+					break;
+			}
+			for (; i + step <= n; i += step){
+				const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first + i));
+				const unsigned mask = _mm_movemask_epi8(lanes::cmpeq(v, needle));
+				if (mask != 0)
+					return i + lowest_bit(mask) / sizeof(T);
+			}
+			return i + find_scalar(first + i, n - i, val);
+		}
+		template<class T>
+		size_t count_sse2(const T *first, size_t n, T val){
+			typedef sse2_lanes<sizeof(T)> lanes;
+			const size_t step = 16 / sizeof(T);
+			const __m128i needle = lanes::set1(val);
+			size_t bits = 0, i = 0;
+			for (; i + step <= n; i += step){
+				const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first + i));
+				bits += popcount(_mm_movemask_epi8(lanes::cmpeq(v, needle)));
+			}
+			return bits / sizeof(T) + count_scalar(first + i, n - i, val);
+		}
+		size_t mismatch_sse2(const unsigned char *a, const unsigned char *b, size_t bytes){
+			size_t i = 0;
+			for (; i + 16 <= bytes; i += 16){
+				const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+				const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+				const unsigned mask = _mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)) ^ 0xFFFFu;
+				if (mask != 0)
+					return i + lowest_bit(mask);
+			}
+			return i + mismatch_scalar(a + i, b + i, bytes - i);
+		}
+
+		template<class T>
+		MYSTL_TARGET_AVX2 size_t find_avx2(const T *first, size_t n, T val){
+			typedef avx2_lanes<sizeof(T)> lanes;
+			const size_t step = 32 / sizeof(T);
+			const __m256i needle = lanes::set1(val);
+			size_t i = 0;
+			for (; i + 4 * step <= n; i += 4 * step){
+				const __m256i *p = reinterpret_cast<const __m256i *>(first + i);
+				const __m256i a = lanes::cmpeq(_mm256_loadu_si256(p), needle);
+				const __m256i b = lanes::cmpeq(_mm256_loadu_si256(p + 1), needle);
+				const __m256i c = lanes::cmpeq(_mm256_loadu_si256(p + 2), needle);
+				const __m256i d = lanes::cmpeq(_mm256_loadu_si256(p + 3), needle);
+				if (_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d))) != 0)
+					break;
+			}
+			for (; i + step <= n; i += step){
+				const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first + i));
+				const unsigned mask = _mm256_movemask_epi8(lanes::cmpeq(v, needle));
+				if (mask != 0)
+					return i + lowest_bit(mask) / sizeof(T);
+			}
+			return i + find_scalar(first + i, n - i, val);
+		}
+		template<class T>
+		MYSTL_TARGET_AVX2 size_t count_avx2(const T *first, size_t n, T val){
+			typedef avx2_lanes<sizeof(T)> lanes;
+			const size_t step = 32 / sizeof(T);
+			const __m256i needle = lanes::set1(val);
+			size_t bits = 0, i = 0;
+			for (; i + step <= n; i += step){
+				const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first + i));
+				bits += popcount(_mm256_movemask_epi8(lanes::cmpeq(v, needle)));
+			}
+			return bits / sizeof(T) + count_scalar(first + i, n - i, val);
+		}
+		MYSTL_TARGET_AVX2 size_t mismatch_avx2(const unsigned char *a, const unsigned char *b, size_t bytes){
+			size_t i = 0;
+			for (; i + 32 <= bytes; i += 32){
+				const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+				const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+				const unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb)));
+				if (mask != 0)
+					return i + lowest_bit(mask);
+			}
+			return i + mismatch_sse2(a + i, b + i, bytes - i);
+		}
+
+		// arithmetic on whole vectors of T, nan gives the lanes holding a NaN
+		template<class T>
+		struct sse2_arith;
+		template<>
+		struct sse2_arith<int32_t>{
+			typedef __m128i vec;
+			static vec load(const int32_t *p){ return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+			static void store(int32_t *p, vec v){ _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v); }
+			static vec zero(){ return _mm_setzero_si128(); }
+			static vec add(vec a, vec b){ return _mm_add_epi32(a, b); }
+			static vec min(vec a, vec b){//sse2 has no 32-bit min, pick by a mask
+				const __m128i lt = _mm_cmplt_epi32(a, b);
+				return _mm_or_si128(_mm_and_si128(lt, a), _mm_andnot_si128(lt, b));
+			}
+			static vec max(vec a, vec b){
+				const __m128i gt = _mm_cmpgt_epi32(a, b);
+				return _mm_or_si128(_mm_and_si128(gt, a), _mm_andnot_si128(gt, b));
+			}
+			static vec nan(vec){ return _mm_setzero_si128(); }
+			static vec or_(vec a, vec b){ return _mm_or_si128(a, b); }
+			static bool any(vec v){ return _mm_movemask_epi8(v) != 0; }
+		};
+		template<>
+		struct sse2_arith<int64_t>{//add only, the extremes stay scalar
+			typedef __m128i vec;
+			static vec load(const int64_t *p){ return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+			static void store(int64_t *p, vec v){ _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v); }
+			static vec zero(){ return _mm_setzero_si128(); }
+			static vec add(vec a, vec b){ return _mm_add_epi64(a, b); }
+		};
+		template<>
+		struct sse2_arith<float>{
+			typedef __m128 vec;
+			static vec load(const float *p){ return _mm_loadu_ps(p); }
+			static void store(float *p, vec v){ _mm_storeu_ps(p, v); }
+			static vec zero(){ return _mm_setzero_ps(); }
+			static vec add(vec a, vec b){ return _mm_add_ps(a, b); }
+			static vec min(vec a, vec b){ return _mm_min_ps(a, b); }
+			static vec max(vec a, vec b){ return _mm_max_ps(a, b); }
+			static vec nan(vec v){ return _mm_cmpunord_ps(v, v); }
+			static vec or_(vec a, vec b){ return _mm_or_ps(a, b); }
+			static bool any(vec v){ return _mm_movemask_ps(v) != 0; }
+		};
+		template<>
+		struct sse2_arith<double>{
+			typedef __m128d vec;
+			static vec load(const double *p){ return _mm_loadu_pd(p); }
+			static void store(double *p, vec v){ _mm_storeu_pd(p, v); }
+			static vec zero(){ return _mm_setzero_pd(); }
+			static vec add(vec a, vec b){ return _mm_add_pd(a, b); }
+			static vec min(vec a, vec b){ return _mm_min_pd(a, b); }
+			static vec max(vec a, vec b){ return _mm_max_pd(a, b); }
+			static vec nan(vec v){ return _mm_cmpunord_pd(v, v); }
+			static vec or_(vec a, vec b){ return _mm_or_pd(a, b); }
+			static bool any(vec v){ return _mm_movemask_pd(v) != 0; }
+		};
+
+		template<class T>
+		struct avx2_arith;
+		template<>
+		struct avx2_arith<int32_t>{
+			typedef __m256i vec;
+			MYSTL_TARGET_AVX2 static vec load(const int32_t *p){ return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+			MYSTL_TARGET_AVX2 static void store(int32_t *p, vec v){ _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v); }
+			MYSTL_TARGET_AVX2 static vec zero(){ return _mm256_setzero_si256(); }
+			MYSTL_TARGET_AVX2 static vec add(vec a, vec b){ return _mm256_add_epi32(a, b); }
+			MYSTL_TARGET_AVX2 static vec min(vec a, vec b){ return _mm256_min_epi32(a, b); }
+			MYSTL_TARGET_AVX2 static vec max(vec a, vec b){ return _mm256_max_epi32(a, b); }
+			MYSTL_TARGET_AVX2 static vec nan(vec){ return _mm256_setzero_si256(); }
+			MYSTL_TARGET_AVX2 static vec or_(vec a, vec b){ return _mm256_or_si256(a, b); }
+			MYSTL_TARGET_AVX2 static bool any(vec v){ return _mm256_movemask_epi8(v) != 0; }
+		};
+		template<>
+		struct avx2_arith<int64_t>{
+			typedef __m256i vec;
+			MYSTL_TARGET_AVX2 static vec load(const int64_t *p){ return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+			MYSTL_TARGET_AVX2 static void store(int64_t *p, vec v){ _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v); }
+			MYSTL_TARGET_AVX2 static vec zero(){ return _mm256_setzero_si256(); }
+			MYSTL_TARGET_AVX2 static vec add(vec a, vec b){ return _mm256_add_epi64(a, b); }
+			MYSTL_TARGET_AVX2 static vec min(vec a, vec b){ return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b)); }
+			MYSTL_TARGET_AVX2 static vec max(vec a, vec b){ return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b)); }
+			MYSTL_TARGET_AVX2 static vec nan(vec){ return _mm256_setzero_si256(); }
+			MYSTL_TARGET_AVX2 static vec or_(vec a, vec b){ return _mm256_or_si256(a, b); }
+			MYSTL_TARGET_AVX2 static bool any(vec v){ return _mm256_movemask_epi8(v) != 0; }
+		};
+		template<>
+		struct avx2_arith<float>{
+			typedef __m256 vec;
+			MYSTL_TARGET_AVX2 static vec load(const float *p){ return _mm256_loadu_ps(p); }
+			MYSTL_TARGET_AVX2 static void store(float *p, vec v){ _mm256_storeu_ps(p, v); }
+			MYSTL_TARGET_AVX2 static vec zero(){ return _mm256_setzero_ps(); }
+			MYSTL_TARGET_AVX2 static vec add(vec a, vec b){ return _mm256_add_ps(a, b); }
+			MYSTL_TARGET_AVX2 static vec min(vec a, vec b){ return _mm256_min_ps(a, b); }
+			MYSTL_TARGET_AVX2 static vec max(vec a, vec b){ return _mm256_max_ps(a, b); }
+			MYSTL_TARGET_AVX2 static vec nan(vec v){ return _mm256_cmp_ps(v, v, _CMP_UNORD_Q); }
+			MYSTL_TARGET_AVX2 static vec or_(vec a, vec b){ return _mm256_or_ps(a, b); }
+			MYSTL_TARGET_AVX2 static bool any(vec v){ return _mm256_movemask_ps(v) != 0; }
+		};
+		template<>
+		struct avx2_arith<double>{
+			typedef __m256d vec;
+			MYSTL_TARGET_AVX2 static vec load(const double *p){ return _mm256_loadu_pd(p); }
+			MYSTL_TARGET_AVX2 static void store(double *p, vec v){ _mm256_storeu_pd(p, v); }
+			MYSTL_TARGET_AVX2 static vec zero(){ return _mm256_setzero_pd(); }
+			MYSTL_TARGET_AVX2 static vec add(vec a, vec b){ return _mm256_add_pd(a, b); }
+			MYSTL_TARGET_AVX2 static vec min(vec a, vec b){ return _mm256_min_pd(a, b); }
+			MYSTL_TARGET_AVX2 static vec max(vec a, vec b){ return _mm256_max_pd(a, b); }
+			MYSTL_TARGET_AVX2 static vec nan(vec v){ return _mm256_cmp_pd(v, v, _CMP_UNORD_Q); }
+			MYSTL_TARGET_AVX2 static vec or_(vec a, vec b){ return _mm256_or_pd(a, b); }
+			MYSTL_TARGET_AVX2 static bool any(vec v){ return _mm256_movemask_pd(v) != 0; }
+		};
+
+		//4 independent sums hide the latency of the adds
+		template<class T>
+		typename sum_type<T>::type sum_sse2(const T *first, size_t n){
+			typedef sse2_arith<T> arith;
+			const size_t step = 16 / sizeof(T);
+			typename arith::vec a = arith::zero(), b = a, c = a, d = a;
+			size_t i = 0;
+			for (; i + 4 * step <= n; i += 4 * step){
+				a = arith::add(a, arith::load(first + i));
+				b = arith::add(b, arith::load(first + i + step));
+				c = arith::add(c, arith::load(first + i + 2 * step));
+				d = arith::add(d, arith::load(first + i + 3 * step));
+			}
+			for (; i + step <= n; i += step)
+				a = arith::add(a, arith::load(first + i));
+			T lanes[16 / sizeof(T)];
+			arith::store(lanes, arith::add(arith::add(a, b), arith::add(c, d)));
+			return sum_scalar(lanes, step) + sum_scalar(first + i, n - i);
+		}
+		//the extreme value is found lane-wise, then looked for to get its first index
+		template<bool Greatest, class T>
+		size_t extreme_sse2(const T *first, size_t n){
+			typedef sse2_arith<T> arith;
+			const size_t step = 16 / sizeof(T);
+			if (n < step)
+				return extreme_scalar<Greatest>(first, n);
+			typename arith::vec best = arith::load(first), nan = arith::nan(best);
+			size_t i = step;
+			for (; i + step <= n; i += step){
+				const typename arith::vec v = arith::load(first + i);
+				best = Greatest ? arith::max(best, v) : arith::min(best, v);
+				nan = arith::or_(nan, arith::nan(v));
+			}
+			if (arith::any(nan))
+				return Detail::SIMD_NO_INDEX;
+			T lanes[16 / sizeof(T)];
+			arith::store(lanes, best);
+			return extreme_finish<Greatest>(first, n, lanes, step, i);
+		}
+
+		template<class T>
+		MYSTL_TARGET_AVX2 typename sum_type<T>::type sum_avx2(const T *first, size_t n){
+			typedef avx2_arith<T> arith;
+			const size_t step = 32 / sizeof(T);
+			typename arith::vec a = arith::zero(), b = a, c = a, d = a;
+			size_t i = 0;
+			for (; i + 4 * step <= n; i += 4 * step){
+				a = arith::add(a, arith::load(first + i));
+				b = arith::add(b, arith::load(first + i + step));
+				c = arith::add(c, arith::load(first + i + 2 * step));
+				d = arith::add(d, arith::load(first + i + 3 * step));
+			}
+			for (; i + step <= n; i += step)
+				a = arith::add(a, arith::load(first + i));
+			T lanes[32 / sizeof(T)];
+			arith::store(lanes, arith::add(arith::add(a, b), arith::add(c, d)));
+			return sum_scalar(lanes, step) + sum_scalar(first + i, n - i);
+		}
+		template<bool Greatest, class T>
+		MYSTL_TARGET_AVX2 size_t extreme_avx2(const T *first, size_t n){
+			typedef avx2_arith<T> arith;
+			const size_t step = 32 / sizeof(T);
+			if (n < step)
+				return extreme_scalar<Greatest>(first, n);
+			typename arith::vec best = arith::load(first), nan = arith::nan(best);
+			size_t i = step;
+			for (; i + step <= n; i += step){
+				const typename arith::vec v = arith::load(first + i);
+				best = Greatest ? arith::max(best, v) : arith::min(best, v);
+				nan = arith::or_(nan, arith::nan(v));
+			}
+			if (arith::any(nan))
+				return Detail::SIMD_NO_INDEX;
+			T lanes[32 / sizeof(T)];
+			arith::store(lanes, best);
+			return extreme_finish<Greatest>(first, n, lanes, step, i);
+		}
+#endif
+
+		template<class T>
+		size_t find_dispatch(const void *first, size_t n, uint64_t val){
+			const T *p = static_cast<const T *>(first);
+#if MYSTL_SIMD_X86
+			if (current_simd_level() == SIMD_AVX2)
+				return find_avx2(p, n, static_cast<T>(val));
+			return find_sse2(p, n, static_cast<T>(val));
+#else
+			return find_scalar(p, n, static_cast<T>(val));
+#endif
+		}
+		template<class T>
+		size_t count_dispatch(const void *first, size_t n, uint64_t val){
+			const T *p = static_cast<const T *>(first);
+#if MYSTL_SIMD_X86
+			if (current_simd_level() == SIMD_AVX2)
+				return count_avx2(p, n, static_cast<T>(val));
+			return count_sse2(p, n, static_cast<T>(val));
+#else
+			return count_scalar(p, n, static_cast<T>(val));
+#endif
+		}
+		template<class T>
+		typename sum_type<T>::type sum_dispatch(const T *first, size_t n){
+#if MYSTL_SIMD_X86
+			if (current_simd_level() == SIMD_AVX2)
+				return sum_avx2(first, n);
+			return sum_sse2(first, n);
+#else
+			return sum_scalar(first, n);
+#endif
+		}
+		template<bool Greatest, class T>
+		size_t extreme_dispatch(const T *first, size_t n){
+#if MYSTL_SIMD_X86
+			if (current_simd_level() == SIMD_AVX2)
+				return extreme_avx2<Greatest>(first, n);
+			return extreme_sse2<Greatest>(first, n);
+#else
+			return extreme_scalar<Greatest>(first, n);
+#endif
+		}
+	}
+
+	simd_level current_simd_level(){
+#if MYSTL_SIMD_X86
+		static const simd_level level = detect_simd_level();
+		return level;
+#else
+		return SIMD_SCALAR;
+#endif
+	}
+
+	namespace Detail{
+		size_t simd_find(const void *first, size_t n, uint64_t val, size_t width){
+			switch (width){
+			case 1: return find_dispatch<uint8_t>(first, n, val);
+			case 2: return find_dispatch<uint16_t>(first, n, val);
+			case 4: return find_dispatch<uint32_t>(first, n, val);
+			default: return find_dispatch<uint64_t>(first, n, val);
+			}
+		}
+		size_t simd_count(const void *first, size_t n, uint64_t val, size_t width){
+			switch (width){
+			case 1: return count_dispatch<uint8_t>(first, n, val);
+			case 2: return count_dispatch<uint16_t>(first, n, val);
+			case 4: return count_dispatch<uint32_t>(first, n, val);
+			default: return count_dispatch<uint64_t>(first, n, val);
+			}
+		}
+		size_t simd_mismatch(const void *a, const void *b, size_t bytes){
+			const unsigned char *pa = static_cast<const unsigned char *>(a), *pb = static_cast<const unsigned char *>(b);
+#if MYSTL_SIMD_X86
+			if (current_simd_level() == SIMD_AVX2)
+				return mismatch_avx2(pa, pb, bytes);
+			return mismatch_sse2(pa, pb, bytes);
+#else
+			return mismatch_scalar(pa, pb, bytes);
+#endif
+		}
+
+		int32_t simd_sum(const int32_t *first, size_t n){ return static_cast<int32_t>(sum_dispatch(first, n)); }
+		int64_t simd_sum(const int64_t *first, size_t n){ return static_cast<int64_t>(sum_dispatch(first, n)); }
+		//the lane adds are the same for both signs
+		uint32_t simd_sum(const uint32_t *first, size_t n){ return sum_dispatch(reinterpret_cast<const int32_t *>(first), n); }
+		uint64_t simd_sum(const uint64_t *first, size_t n){ return sum_dispatch(reinterpret_cast<const int64_t *>(first), n); }
+		float simd_sum(const float *first, size_t n){ return sum_dispatch(first, n); }
+		double simd_sum(const double *first, size_t n){ return sum_dispatch(first, n); }
+
+		size_t simd_min_index(const int32_t *first, size_t n){ return extreme_dispatch<false>(first, n); }
+		size_t simd_min_index(const int64_t *first, size_t n){
+#if MYSTL_SIMD_X86
+			if (current_simd_level() == SIMD_AVX2)
+				return extreme_avx2<false>(first, n);
+#endif
+			return extreme_scalar<false>(first, n);
+		}
+		size_t simd_min_index(const float *first, size_t n){ return extreme_dispatch<false>(first, n); }
+		size_t simd_min_index(const double *first, size_t n){ return extreme_dispatch<false>(first, n); }
+
+		size_t simd_max_index(const int32_t *first, size_t n){ return extreme_dispatch<true>(first, n); }
+		size_t simd_max_index(const int64_t *first, size_t n){
+#if MYSTL_SIMD_X86
+			if (current_simd_level() == SIMD_AVX2)
+				return extreme_avx2<true>(first, n);
+#endif
+			return extreme_scalar<true>(first, n);
+		}
+		size_t simd_max_index(const float *first, size_t n){ return extreme_dispatch<true>(first, n); }
+		size_t simd_max_index(const double *first, size_t n){ return extreme_dispatch<true>(first, n); }
+	}
+}
\ No newline at end of file
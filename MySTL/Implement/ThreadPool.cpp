@@ -0,0 +1,104 @@
+#include "ThreadPool.h"
+
+namespace MySTL{
+	namespace{
+		// the pool and queue of the worker running on this thread
+		thread_local const thread_pool *current_pool = 0;
+		thread_local size_t current_index = 0;
+	}
+
+	thread_pool::thread_pool(size_t threads)
+		:queues_(new task_queue[threads + 1]), workers_(new std::thread[threads]),
+		size_(threads), queued_(0), stop_(false){
+		for (size_t i = 0; i != size_; ++i)
+			workers_[i] = std::thread(&thread_pool::work, this, i);
+	}
+	thread_pool::~thread_pool(){
+		{
+			std::lock_guard<std::mutex> guard(sleep_lock_);
+			stop_ = true;
+		}
+		wakeup_.notify_all();
+		for (size_t i = 0; i != size_; ++i)
+			workers_[i].join();
+		delete[] workers_;
+		delete[] queues_;
+	}
+	thread_pool& thread_pool::default_pool(){
+		static thread_pool pool(std::thread::hardware_concurrency() > 1 ?
+			std::thread::hardware_concurrency() - 1 : 0);
+		return pool;
+	}
+	size_t thread_pool::self_index()const{
+		return current_pool == this ? current_index : size_;
+	}
+	void thread_pool::submit(task_type task){
+		{
+			//counted under the lock so that a worker going to sleep can not miss it
+			std::lock_guard<std::mutex> guard(sleep_lock_);
+			queued_.fetch_add(1);
+		}
+		auto& queue = queues_[self_index()];
+		{
+			std::lock_guard<std::mutex> guard(queue.lock_);
+			queue.tasks_.push_back(std::move(task));
+		}
+		wakeup_.notify_one();
+	}
+	bool thread_pool::pop(size_t index, task_type& task){
+		auto& queue = queues_[index];
+		std::lock_guard<std::mutex> guard(queue.lock_);
+		if (queue.tasks_.empty())
+			return false;
+		task = std::move(queue.tasks_.back());
+		queue.tasks_.pop_back();
+		return true;
+	}
+	bool thread_pool::steal(size_t index, task_type& task){
+		for (size_t i = 1; i != size_ + 1; ++i){
+			auto& queue = queues_[(index + i) % (size_ + 1)];
+			std::unique_lock<std::mutex> guard(queue.lock_, std::try_to_lock);
+			if (!guard.owns_lock() || queue.tasks_.empty())
+				continue;
+			task = std::move(queue.tasks_.front());
+			queue.tasks_.pop_front();
+			return true;
+		}
+		return false;
+	}
+	bool thread_pool::try_run(size_t index){
+		task_type task;
+		if (!pop(index, task) && !steal(index, task))
+			return false;
+		queued_.fetch_sub(1);
+		task();
+		return true;
+	}
+	bool thread_pool::run_one(){
+		return try_run(self_index());
+	}
+	void thread_pool::work(size_t index){
+		current_pool = this;
+		current_index = index;
+		while (true){
+			if (try_run(index))
+				continue;
+			std::unique_lock<std::mutex> guard(sleep_lock_);
+			if (queued_.load() != 0){//a task is being pushed or a queue was busy, retry
+				guard.unlock();
+				std::this_thread::yield();
+				continue;
+			}
+			if (stop_)
+				return;
+			wakeup_.wait(guard, [this]{ return stop_ || queued_.load() != 0; });
+		}
+	}
+
+	void task_group::wait(){
+		while (pending_.load(std::memory_order_acquire) != 0){
+			if (!pool_.run_one())
+				std::this_thread::yield();
+		}
+	}
+}
\ No newline at end of file
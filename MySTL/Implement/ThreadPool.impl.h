@@ -0,0 +1,25 @@
+#ifndef _THREAD_POOL_IMPL_H_
+#define _THREAD_POOL_IMPL_H_
+
+namespace MySTL{
+	template<class Function>
+	void task_group::run(Function func){
+		pending_.fetch_add(1);
+		auto pending = &pending_;
+		pool_.submit([func, pending]() mutable{
+			//the count drops however func leaves, so wait() can not spin forever
+			struct done_guard{
+				std::atomic<size_t> *pending_;
+				~done_guard(){ pending_->fetch_sub(1, std::memory_order_release); }
+			} done = { pending };
+			try{
+				func();
+			}
+			catch (...){//like the std parallel algorithms, an escaping exception terminates
+				std::terminate();
+			}
+		});
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,56 @@
+#ifndef _UNORDERED_MAP_IMPL_H_
+#define _UNORDERED_MAP_IMPL_H_
+
+#include <utility>//for forward
+
+namespace MySTL{
+	template<class Key, class T, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	typename Unordered_map<Key, T, Hash, KeyEqual, Allocator, BucketPolicy>::mapped_type&
+		Unordered_map<Key, T, Hash, KeyEqual, Allocator, BucketPolicy>::operator[](const key_type& key){
+		return try_emplace(key).first->second;
+	}
+	template<class Key, class T, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	MySTL::pair<typename Unordered_map<Key, T, Hash, KeyEqual, Allocator, BucketPolicy>::iterator, bool>
+		Unordered_map<Key, T, Hash, KeyEqual, Allocator, BucketPolicy>::insert(const value_type& val){
+		return table_.find_or_insert(val.first, [&val]()->const value_type&{ return val; });
+	}
+	template<class Key, class T, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	template<class InputIterator>
+	void Unordered_map<Key, T, Hash, KeyEqual, Allocator, BucketPolicy>::insert(InputIterator first, InputIterator last){
+		table_.insert(first, last);
+	}
+	template<class Key, class T, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	template<class... Args>
+	MySTL::pair<typename Unordered_map<Key, T, Hash, KeyEqual, Allocator, BucketPolicy>::iterator, bool>
+		Unordered_map<Key, T, Hash, KeyEqual, Allocator, BucketPolicy>::try_emplace(const key_type& key, Args&&... args){
+		//the mapped value is only built when the key is new
+		return table_.find_or_insert(key, [&]{ return value_type(key, mapped_type(std::forward<Args>(args)...)); });
+	}
+	template<class Key, class T, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	template<class M>
+	MySTL::pair<typename Unordered_map<Key, T, Hash, KeyEqual, Allocator, BucketPolicy>::iterator, bool>
+		Unordered_map<Key, T, Hash, KeyEqual, Allocator, BucketPolicy>::insert_or_assign(const key_type& key, M&& obj){
+		auto res = table_.find_or_insert(key, [&]{ return value_type(key, std::forward<M>(obj)); });
+		if (!res.second)
+			res.first->second = std::forward<M>(obj);
+		return res;
+	}
+	template<class Key, class T, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	typename Unordered_map<Key, T, Hash, KeyEqual, Allocator, BucketPolicy>::size_type
+		Unordered_map<Key, T, Hash, KeyEqual, Allocator, BucketPolicy>::erase(const key_type& key){
+		auto it = find(key);
+		if (it == end()){
+			return 0;
+		}
+		else{
+			table_.erase(it);
+			return 1;
+		}
+	}
+	template<class Key, class T, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	void swap(Unordered_map<Key, T, Hash, KeyEqual, Allocator, BucketPolicy>& lhs,
+		Unordered_map<Key, T, Hash, KeyEqual, Allocator, BucketPolicy>& rhs){
+		MySTL::swap(lhs.table_, rhs.table_);
+	}
+}
+#endif
\ No newline at end of file
@@ -1,28 +1,70 @@
 #ifndef _UNORDERED_SET_IMPL_H_
 #define _UNORDERED_SET_IMPL_H_
 
-#include <functional>//for bind
+#include <functional>//for hash
 
 namespace MySTL{
+	inline size_t prime_bucket_policy::bucket_count(size_t n){
+#define PRIME_LIST_SIZE 28
+		static const size_t prime_list_[PRIME_LIST_SIZE] = {
+			53, 97, 193, 389, 769, 1543, 3079, 6151, 12289, 24593, 49157, 98317, 196613, 393241,
+			786433, 1572869, 3145739, 6291469, 12582917, 25165843, 50331653, 100663319, 201326611,
+			402653189, 805306457, 1610612741, 3221225473, 4294967291,
+		};
+		auto i = 0;
+		for (; i != PRIME_LIST_SIZE; ++i){
+			if (n > prime_list_[i])
+				continue;
+			else
+				break;
+		}
+		i = (i == PRIME_LIST_SIZE ? PRIME_LIST_SIZE - 1 : i);
+		return prime_list_[i];
+	}
+	inline size_t fastrange_bucket_policy::index(size_t hash, size_t count){
+		//fold and mix the hash into 32 bits, then take the high half of hash * count,
+		//which lies in [0, count) as all the primes are below 2^32
+		unsigned long long h = hash;
+		h ^= h >> 32;
+		h *= 0x9e3779b97f4a7c15ull;
+		return (size_t)(((h >> 32) * count) >> 32);
+	}
+	inline size_t power2_bucket_policy::bucket_count(size_t n){
+		size_t count = 64;
+		while (count < n)
+			count <<= 1;
+		return count;
+	}
+	inline size_t power2_bucket_policy::index(size_t hash, size_t count){
+		//the finalizer of murmurhash3, so that every bit of hash reaches the low bits
+		unsigned long long h = hash;
+		h ^= h >> 33;
+		h *= 0xff51afd7ed558ccdull;
+		h ^= h >> 33;
+		return (size_t)h & (count - 1);
+	}
+
 	namespace Detail{
-		template<class Key, class ListIterator, class Hash, class KeyEqual, class Allocator>
-		ust_iterator<Key, ListIterator, Hash, KeyEqual, Allocator>::ust_iterator(size_t index, ListIterator it, cntrPtr ptr)
+		template<class Key, class ListIterator, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+		ust_iterator<Key, ListIterator, Hash, KeyEqual, Allocator, BucketPolicy>::ust_iterator(size_t index, ListIterator it, cntrPtr ptr)
 			:bucket_index_(index), iterator_(it), container_(ptr){}
-		template<class Key, class ListIterator, class Hash, class KeyEqual, class Allocator>
-		ust_iterator<Key, ListIterator, Hash, KeyEqual, Allocator>&
-			ust_iterator<Key, ListIterator, Hash, KeyEqual, Allocator>::operator ++(){
+		template<class Key, class ListIterator, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+		ust_iterator<Key, ListIterator, Hash, KeyEqual, Allocator, BucketPolicy>&
+			ust_iterator<Key, ListIterator, Hash, KeyEqual, Allocator, BucketPolicy>::operator ++(){
 			++iterator_;
 			//ǰһλ󵽴listĩβҪתһitembucketlist
-			if (iterator_ == container_->buckets_[bucket_index_].end()){
+			if (iterator_ == ListIterator()){
+				//while migrating, the old buckets follow the last bucket of buckets_
+				auto last = container_->buckets_.size() + container_->old_buckets_.size() - 1;
 				for (;;){
-					if (bucket_index_ == container_->buckets_.size() - 1){
+					if (bucket_index_ >= last){
 						*this = container_->end();
 						break;
 					}
 					else{
 						++bucket_index_;
-						if (!(container_->buckets_[bucket_index_].empty())){//listΪ
-							iterator_ = container_->buckets_[bucket_index_].begin();
+						if (container_->head(bucket_index_) != nullptr){//listΪ
+							iterator_ = ListIterator(container_->head(bucket_index_));
 							break;
 						}
 					}
@@ -30,211 +72,331 @@ namespace MySTL{
 			}
 			return *this;
 		}
-		template<class Key, class ListIterator, class Hash, class KeyEqual, class Allocator>
-		ust_iterator<Key, ListIterator, Hash, KeyEqual, Allocator>
-			ust_iterator<Key, ListIterator, Hash, KeyEqual, Allocator>::operator ++(int){
+		template<class Key, class ListIterator, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+		ust_iterator<Key, ListIterator, Hash, KeyEqual, Allocator, BucketPolicy>
+			ust_iterator<Key, ListIterator, Hash, KeyEqual, Allocator, BucketPolicy>::operator ++(int){
 			auto res = *this;
 			++*this;
 			return res;
 		}
-		template<class Key, class ListIterator, class Hash, class KeyEqual, class Allocator>
-		bool operator ==(const ust_iterator<Key, ListIterator, Hash, KeyEqual, Allocator>& lhs,
-			const ust_iterator<Key, ListIterator, Hash, KeyEqual, Allocator>& rhs){
+		template<class Key, class ListIterator, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+		bool operator ==(const ust_iterator<Key, ListIterator, Hash, KeyEqual, Allocator, BucketPolicy>& lhs,
+			const ust_iterator<Key, ListIterator, Hash, KeyEqual, Allocator, BucketPolicy>& rhs){
 			return lhs.bucket_index_ == rhs.bucket_index_ &&
 				lhs.iterator_ == rhs.iterator_ &&
 				lhs.container_ == rhs.container_;
 		}
-		template<class Key, class ListIterator, class Hash, class KeyEqual, class Allocator>
-		bool operator !=(const ust_iterator<Key, ListIterator, Hash, KeyEqual, Allocator>& lhs,
-			const ust_iterator<Key, ListIterator, Hash, KeyEqual, Allocator>& rhs){
+		template<class Key, class ListIterator, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+		bool operator !=(const ust_iterator<Key, ListIterator, Hash, KeyEqual, Allocator, BucketPolicy>& lhs,
+			const ust_iterator<Key, ListIterator, Hash, KeyEqual, Allocator, BucketPolicy>& rhs){
 			return !(lhs == rhs);
 		}
 	}//end of Detail namespace
 
-	template<class Key, class Hash, class KeyEqual, class Allocator>
-	typename Unordered_set<Key, Hash, KeyEqual, Allocator>::size_type
-		Unordered_set<Key, Hash, KeyEqual, Allocator>::size()const{
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	typename Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::size_type
+		Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::size()const{
 		return size_;
 	}
-	template<class Key, class Hash, class KeyEqual, class Allocator>
-	bool Unordered_set<Key, Hash, KeyEqual, Allocator>::empty()const{
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	bool Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::empty()const{
 		return size() == 0;
 	}
-	template<class Key, class Hash, class KeyEqual, class Allocator>
-	typename Unordered_set<Key, Hash, KeyEqual, Allocator>::size_type
-		Unordered_set<Key, Hash, KeyEqual, Allocator>::bucket_count()const{
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	typename Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::size_type
+		Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::bucket_count()const{
 		return buckets_.size();
 	}
-	template<class Key, class Hash, class KeyEqual, class Allocator>
-	typename Unordered_set<Key, Hash, KeyEqual, Allocator>::size_type
-		Unordered_set<Key, Hash, KeyEqual, Allocator>::bucket_size(size_type i)const{
-		return buckets_[i].size();
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	typename Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::size_type
+		Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::bucket_size(size_type i)const{
+		size_type n = 0;
+		for (auto p = buckets_[i]; p != nullptr; p = p->next)
+			++n;
+		return n;
 	}
-	template<class Key, class Hash, class KeyEqual, class Allocator>
-	typename Unordered_set<Key, Hash, KeyEqual, Allocator>::size_type
-		Unordered_set<Key, Hash, KeyEqual, Allocator>::bucket(const key_type& key)const{
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	typename Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::size_type
+		Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::bucket(const key_type& key)const{
 		return bucket_index(key);
 	}
-	template<class Key, class Hash, class KeyEqual, class Allocator>
-	float Unordered_set<Key, Hash, KeyEqual, Allocator>::load_factor()const{
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	template<class K>
+	typename Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::size_type
+		Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::bucket(const K& key)const{
+		return bucket_index(key);
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	float Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::load_factor()const{
 		return (float)size() / (float)bucket_count();
 	}
-	template<class Key, class Hash, class KeyEqual, class Allocator>
-	typename Unordered_set<Key, Hash, KeyEqual, Allocator>::haser
-		Unordered_set<Key, Hash, KeyEqual, Allocator>::hash_function()const{
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	typename Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::haser
+		Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::hash_function()const{
 		return haser();
 	}
-	template<class Key, class Hash, class KeyEqual, class Allocator>
-	typename Unordered_set<Key, Hash, KeyEqual, Allocator>::key_equal
-		Unordered_set<Key, Hash, KeyEqual, Allocator>::key_eq()const{
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	typename Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::key_equal
+		Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::key_eq()const{
 		return key_equal();
 	}
-	template<class Key, class Hash, class KeyEqual, class Allocator>
-	typename Unordered_set<Key, Hash, KeyEqual, Allocator>::allocator_type
-		Unordered_set<Key, Hash, KeyEqual, Allocator>::get_allocator()const{
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	typename Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::allocator_type
+		Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::get_allocator()const{
 		return allocator_type();
 	}
-	template<class Key, class Hash, class KeyEqual, class Allocator>
-	size_t Unordered_set<Key, Hash, KeyEqual, Allocator>::prime_list_[PRIME_LIST_SIZE] = {
-		53, 97, 193, 389, 769, 1543, 3079, 6151, 12289, 24593, 49157, 98317, 196613, 393241,
-		786433, 1572869, 3145739, 6291469, 12582917, 25165843, 50331653, 100663319, 201326611,
-		402653189, 805306457, 1610612741, 3221225473, 4294967291,
-	};
-	template<class Key, class Hash, class KeyEqual, class Allocator>
-	bool Unordered_set<Key, Hash, KeyEqual, Allocator>::has_key(const key_type& key){
-		auto& list = buckets_[bucket_index(key)];
-		auto pred = std::bind(KeyEqual(), key, std::placeholders::_1);
-		return MySTL::find_if(list.begin(), list.end(), pred) != list.end();
-	}
-	template<class Key, class Hash, class KeyEqual, class Allocator>
-	typename Unordered_set<Key, Hash, KeyEqual, Allocator>::size_type
-		Unordered_set<Key, Hash, KeyEqual, Allocator>::bucket_index(const key_type& key)const{
-		return haser()(key) % buckets_.size();
-	}
-	template<class Key, class Hash, class KeyEqual, class Allocator>
-	typename Unordered_set<Key, Hash, KeyEqual, Allocator>::size_type
-		Unordered_set<Key, Hash, KeyEqual, Allocator>::next_prime(size_type n)const{
-		auto i = 0;
-		for (; i != PRIME_LIST_SIZE; ++i){
-			if (n > prime_list_[i])
-				continue;
-			else
-				break;
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	template<class K>
+	typename Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::size_type
+		Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::bucket_index(const K& key)const{
+		return BucketPolicy::index(haser()(key), buckets_.size());
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	typename Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::size_type
+		Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::next_bucket_count(size_type n)const{
+		return BucketPolicy::bucket_count(n);
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	typename Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::node_type*&
+		Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::head(size_type i){
+		return i < buckets_.size() ? buckets_[i] : old_buckets_[i - buckets_.size()];
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	typename Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::node_type*
+		Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::new_node(const value_type& val, node_type *next){
+		node_type *res = nodeAllocator::allocate();
+		new(res)node_type(val, next);
+		return res;
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	void Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::delete_node(node_type *p){
+		nodeAllocator::destroy(p);
+		nodeAllocator::deallocate(p);
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	void Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::destroy_table(MySTL::vector<node_type*>& table){
+		for (size_type i = 0; i != table.size(); ++i){
+			for (auto p = table[i]; p != nullptr;){
+				auto next = p->next;
+				delete_node(p);
+				p = next;
+			}
+			table[i] = nullptr;
+		}
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	void Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::copy_table(MySTL::vector<node_type*>& to, const MySTL::vector<node_type*>& from){
+		to.resize(from.size());
+		for (size_type i = 0; i != from.size(); ++i){
+			auto link = &to[i];//keep the order of the chain
+			for (auto p = from[i]; p != nullptr; p = p->next){
+				*link = new_node(p->value, nullptr);
+				link = &(*link)->next;
+			}
 		}
-		i = (i == PRIME_LIST_SIZE ? PRIME_LIST_SIZE - 1 : i);
-		return prime_list_[i];
 	}
-	template<class Key, class Hash, class KeyEqual, class Allocator>
-	Unordered_set<Key, Hash, KeyEqual, Allocator>::Unordered_set(const Unordered_set& ust){
-		buckets_ = ust.buckets_;
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::Unordered_set(const Unordered_set& ust){
+		copy_table(buckets_, ust.buckets_);
 		size_ = ust.size_;
 		max_load_factor_ = ust.max_load_factor_;
+		incremental_ = ust.incremental_;
+		copy_table(old_buckets_, ust.old_buckets_);
+		migrate_index_ = ust.migrate_index_;
 	}
-	template<class Key, class Hash, class KeyEqual, class Allocator>
-	Unordered_set<Key, Hash, KeyEqual, Allocator>& Unordered_set<Key, Hash, KeyEqual, Allocator>::operator = (const Unordered_set& ust){
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>& Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::operator = (const Unordered_set& ust){
 		if (this != &ust){
-			buckets_ = ust.buckets_;
-			size_ = ust.size_;
-			max_load_factor_ = ust.max_load_factor_;
+			Unordered_set temp(ust);
+			swap(*this, temp);//the friend swap below, MySTL::swap would copy again
 		}
+		return *this;
 	}
-	template<class Key, class Hash, class KeyEqual, class Allocator>
-	Unordered_set<Key, Hash, KeyEqual, Allocator>::Unordered_set(size_type bucket_count){
-		bucket_count = next_prime(bucket_count);
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::~Unordered_set(){
+		destroy_table(buckets_);
+		destroy_table(old_buckets_);
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::Unordered_set(size_type bucket_count){
+		bucket_count = next_bucket_count(bucket_count);
 		buckets_.resize(bucket_count);
 		size_ = 0;
 		max_load_factor_ = 1.0;
+		incremental_ = false;
+		migrate_index_ = 0;
 	}
-	template<class Key, class Hash, class KeyEqual, class Allocator>
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
 	template<class InputIterator>
-	Unordered_set<Key, Hash, KeyEqual, Allocator>::Unordered_set(InputIterator first, InputIterator last){
+	Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::Unordered_set(InputIterator first, InputIterator last){
 		size_ = 0;
 		max_load_factor_ = 1.0;
-		auto len = last - first;
-		buckets_.resize(next_prime(len));
-		for (; first != last; ++first){
-			auto index = bucket_index(*first);
-			if (!has_key(*first)){
-				buckets_[index].push_front(*first);
-				++size_;
-			}
-		}
+		incremental_ = false;
+		migrate_index_ = 0;
+		buckets_.resize(next_bucket_count(0));
+		insert(first, last);
 	}
-	template<class Key, class Hash, class KeyEqual, class Allocator>
-	typename Unordered_set<Key, Hash, KeyEqual, Allocator>::iterator
-		Unordered_set<Key, Hash, KeyEqual, Allocator>::begin(){
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	typename Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::iterator
+		Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::begin(){
+		migrate_all();//a full traversal is O(n) anyway, so finish the pending migration first
 		size_type index = 0;
 		for (; index != buckets_.size(); ++index){
-			if (!(buckets_[index].empty()))
+			if (buckets_[index] != nullptr)
 				break;
 		}
 		if (index == buckets_.size())
 			return end();
-		return iterator(index, buckets_[index].begin(), this);
-	}
-	template<class Key, class Hash, class KeyEqual, class Allocator>
-	typename Unordered_set<Key, Hash, KeyEqual, Allocator>::iterator
-		Unordered_set<Key, Hash, KeyEqual, Allocator>::end(){
-		return iterator(buckets_.size() - 1, buckets_[buckets_.size() - 1].end(), this);
-	}
-	template<class Key, class Hash, class KeyEqual, class Allocator>
-	typename Unordered_set<Key, Hash, KeyEqual, Allocator>::local_iterator
-		Unordered_set<Key, Hash, KeyEqual, Allocator>::begin(size_type i){
-		return buckets_[i].begin();
-	}
-	template<class Key, class Hash, class KeyEqual, class Allocator>
-	typename Unordered_set<Key, Hash, KeyEqual, Allocator>::local_iterator
-		Unordered_set<Key, Hash, KeyEqual, Allocator>::end(size_type i){
-		return buckets_[i].end();
-	}
-	template<class Key, class Hash, class KeyEqual, class Allocator>
-	typename Unordered_set<Key, Hash, KeyEqual, Allocator>::iterator
-		Unordered_set<Key, Hash, KeyEqual, Allocator>::find(const key_type& key){
+		return iterator(index, local_iterator(buckets_[index]), this);
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	typename Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::iterator
+		Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::end(){
+		return iterator(buckets_.size() - 1, local_iterator(), this);
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	typename Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::local_iterator
+		Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::begin(size_type i){
+		migrate_all();
+		return local_iterator(buckets_[i]);
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	typename Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::local_iterator
+		Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::end(size_type i){
+		return local_iterator();
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	typename Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::iterator
+		Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::find(const key_type& key){
+		return find<key_type>(key);
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	template<class K>
+	typename Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::iterator
+		Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::find(const K& key){
+		migrate_key(key);
+		migrate_step();
 		auto index = bucket_index(key);
-		for (auto it = begin(index); it != end(index); ++it){
-			if (key_equal()(key, *it))
-				return iterator(index, it, this);
+		for (auto p = buckets_[index]; p != nullptr; p = p->next){
+			if (key_equal()(key, p->value))
+				return iterator(index, local_iterator(p), this);
 		}
 		return end();
 	}
-	template<class Key, class Hash, class KeyEqual, class Allocator>
-	typename Unordered_set<Key, Hash, KeyEqual, Allocator>::size_type
-		Unordered_set<Key, Hash, KeyEqual, Allocator>::count(const key_type& key){
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	typename Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::size_type
+		Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::count(const key_type& key){
 		auto it = find(key);
 		return it == end() ? 0 : 1;
 	}
-	template<class Key, class Hash, class KeyEqual, class Allocator>
-	MySTL::pair<typename Unordered_set<Key, Hash, KeyEqual, Allocator>::iterator, bool>
-		Unordered_set<Key, Hash, KeyEqual, Allocator>::insert(const value_type& val){
-		if (!has_key(val)){
-			if (load_factor() > max_load_factor())
-				rehash(next_prime(size()));
-			auto index = bucket_index(val);
-			buckets_[index].push_front(val);
-			++size_;
-			return MySTL::pair<iterator, bool>(iterator(index, buckets_[index].begin(), this), true);
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	template<class K>
+	void Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::find_batch(const K *keys, size_type n, iterator *out){
+		size_type index[PREFETCH_BATCH];
+		local_iterator pos[PREFETCH_BATCH];
+		for (size_type base = 0; base < n; base += PREFETCH_BATCH){
+			size_type m = MySTL::min(n - base, (size_type)PREFETCH_BATCH);
+			probe_group(keys + base, m, index, pos);
+			for (size_type i = 0; i != m; ++i)
+				out[base + i] = (pos[i] == local_iterator() ? end() : iterator(index[i], pos[i], this));
+		}
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	template<class K>
+	void Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::contains_batch(const K *keys, size_type n, bool *out){
+		size_type index[PREFETCH_BATCH];
+		local_iterator pos[PREFETCH_BATCH];
+		for (size_type base = 0; base < n; base += PREFETCH_BATCH){
+			size_type m = MySTL::min(n - base, (size_type)PREFETCH_BATCH);
+			probe_group(keys + base, m, index, pos);
+			for (size_type i = 0; i != m; ++i)
+				out[base + i] = (pos[i] != local_iterator());
 		}
-		return MySTL::pair<iterator, bool>(end(), false);
 	}
-	template<class Key, class Hash, class KeyEqual, class Allocator>
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	MySTL::pair<typename Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::iterator, bool>
+		Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::insert(const value_type& val){
+		return find_or_insert(val, [&val]()->const value_type&{ return val; });
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	template<class K, class Make>
+	MySTL::pair<typename Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::iterator, bool>
+		Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::find_or_insert(const K& key, Make make){
+		auto hash = haser()(key);
+		migrate_hash(hash);
+		migrate_step();
+		auto index = BucketPolicy::index(hash, buckets_.size());
+		for (auto p = buckets_[index]; p != nullptr; p = p->next){
+			if (key_equal()(key, p->value))
+				return MySTL::pair<iterator, bool>(iterator(index, local_iterator(p), this), false);
+		}
+		if (load_factor() > max_load_factor()){
+			rehash(next_bucket_count(size()));
+			index = BucketPolicy::index(hash, buckets_.size());//the new table reuses the hash
+		}
+		buckets_[index] = new_node(make(), buckets_[index]);
+		++size_;
+		return MySTL::pair<iterator, bool>(iterator(index, local_iterator(buckets_[index]), this), true);
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
 	template<class InputIterator>
-	void Unordered_set<Key, Hash, KeyEqual, Allocator>::insert(InputIterator first, InputIterator last){
+	void Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::insert(InputIterator first, InputIterator last){
+		insert_aux(first, last, typename iterator_traits<InputIterator>::iterator_category());
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	template<class InputIterator>
+	void Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::insert_aux(InputIterator first, InputIterator last, input_iterator_tag){
 		for (; first != last; ++first){
 			insert(*first);
 		}
 	}
-	template<class Key, class Hash, class KeyEqual, class Allocator>
-	typename Unordered_set<Key, Hash, KeyEqual, Allocator>::iterator
-		Unordered_set<Key, Hash, KeyEqual, Allocator>::erase(iterator position){
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	template<class ForwardIterator>
+	void Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::insert_aux(ForwardIterator first, ForwardIterator last, forward_iterator_tag){
+		size_type len = 0;
+		for (auto it = first; it != last; ++it)
+			++len;
+		reserve(size() + len);//duplicates only make this an over-estimate
+		migrate_all();
+		size_type index[PREFETCH_BATCH];
+		while (first != last){
+			//1.hash the batch and prefetch the heads of the target buckets
+			auto batch = first;
+			size_type n = 0;
+			for (; n != PREFETCH_BATCH && first != last; ++n, ++first){
+				index[n] = bucket_index(*first);
+				MySTL::prefetch(&buckets_[index[n]]);
+			}
+			//2.prefetch the first node of each bucket
+			for (size_type i = 0; i != n; ++i)
+				MySTL::prefetch(buckets_[index[i]]);
+			//3.insert, the table is already big enough so no rehash can happen
+			for (size_type i = 0; i != n; ++i, ++batch){
+				auto p = buckets_[index[i]];
+				while (p != nullptr && !key_equal()(*batch, p->value))
+					p = p->next;
+				if (p == nullptr){
+					buckets_[index[i]] = new_node(*batch, buckets_[index[i]]);
+					++size_;
+				}
+			}
+		}
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	typename Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::iterator
+		Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::erase(iterator position){
 		--size_;
 		auto t = position++;
-		auto index = t.bucket_index_;
-		auto it = buckets_[index].erase(t.iterator_);
+		auto link = &head(t.bucket_index_);//find the link that points to the node
+		while (*link != t.iterator_.p)
+			link = &(*link)->next;
+		*link = t.iterator_.p->next;
+		delete_node(t.iterator_.p);
 		return position;
 	}
-	template<class Key, class Hash, class KeyEqual, class Allocator>
-	typename Unordered_set<Key, Hash, KeyEqual, Allocator>::size_type
-		Unordered_set<Key, Hash, KeyEqual, Allocator>::erase(const key_type& key){
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	typename Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::size_type
+		Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::erase(const key_type& key){
 		auto it = find(key);
 		if (it == end()){
 			return 0;
@@ -244,30 +406,116 @@ namespace MySTL{
 			return 1;
 		}
 	}
-	template<class Key, class Hash, class KeyEqual, class Allocator>
-	float Unordered_set<Key, Hash, KeyEqual, Allocator>::max_load_factor()const{
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	float Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::max_load_factor()const{
 		return max_load_factor_;
 	}
-	template<class Key, class Hash, class KeyEqual, class Allocator>
-	void Unordered_set<Key, Hash, KeyEqual, Allocator>::max_load_factor(float z){
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	void Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::max_load_factor(float z){
 		max_load_factor_ = z;
 	}
-	template<class Key, class Hash, class KeyEqual, class Allocator>
-	void Unordered_set<Key, Hash, KeyEqual, Allocator>::rehash(size_type n){
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	void Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::rehash(size_type n){
 		if (n <= buckets_.size())
 			return;
-		Unordered_set temp(next_prime(n));
-		for (auto& val : *this){
-			temp.insert(val);
+		//keep the current table as old_buckets_ and relink its nodes into the new one,
+		//in incremental mode the following operations move REHASH_STEP buckets at a time
+		//the new heads are still zero-filled here at once, one pointer per bucket, which
+		//is far less than relinking every node but is not spread out
+		migrate_all();
+		buckets_.swap(old_buckets_);
+		buckets_.resize(next_bucket_count(n));
+		migrate_index_ = 0;
+		if (!incremental_)
+			migrate_all();
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	void Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::reserve(size_type n){
+		rehash((size_type)((float)n / max_load_factor()) + 1);
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	bool Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::incremental_rehash()const{
+		return incremental_;
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	void Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::incremental_rehash(bool enable){
+		if (!enable)
+			migrate_all();
+		incremental_ = enable;
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	bool Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::migrating()const{
+		return !old_buckets_.empty();
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	void Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::migrate_bucket(size_type i){
+		auto p = old_buckets_[i];
+		old_buckets_[i] = nullptr;
+		while (p != nullptr){//relink the nodes, no element is copied
+			auto next = p->next;
+			auto index = bucket_index(p->value);
+			p->next = buckets_[index];
+			buckets_[index] = p;
+			p = next;
+		}
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	template<class K>
+	void Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::migrate_key(const K& key){
+		if (migrating())
+			migrate_hash(haser()(key));
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	void Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::migrate_hash(size_t hash){
+		if (migrating())
+			migrate_bucket(BucketPolicy::index(hash, old_buckets_.size()));
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	void Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::migrate_step(){
+		if (!migrating())
+			return;
+		for (size_type n = 0; n != REHASH_STEP && migrate_index_ != old_buckets_.size(); ++n, ++migrate_index_)
+			migrate_bucket(migrate_index_);
+		if (migrate_index_ == old_buckets_.size()){
+			MySTL::vector<node_type*>().swap(old_buckets_);
+			migrate_index_ = 0;
+		}
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	void Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::migrate_all(){
+		while (migrating())
+			migrate_step();
+	}
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	template<class K>
+	void Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>::probe_group(const K *keys, size_type m, size_type *index, local_iterator *pos){
+		//1.hash the group and prefetch the heads of the target buckets
+		for (size_type i = 0; i != m; ++i){
+			migrate_key(keys[i]);
+			index[i] = bucket_index(keys[i]);
+			MySTL::prefetch(&buckets_[index[i]]);
+		}
+		migrate_step();
+		//2.prefetch the first node of each bucket
+		for (size_type i = 0; i != m; ++i)
+			MySTL::prefetch(buckets_[index[i]]);
+		//3.search the buckets, whose heads should be in cache by now
+		for (size_type i = 0; i != m; ++i){
+			auto p = buckets_[index[i]];
+			while (p != nullptr && !key_equal()(keys[i], p->value))
+				p = p->next;
+			pos[i] = local_iterator(p);
 		}
-		MySTL::swap(*this, temp);
 	}
-	template<class Key, class Hash, class KeyEqual, class Allocator>
-	void swap(Unordered_set<Key, Hash, KeyEqual, Allocator>& lhs,
-		Unordered_set<Key, Hash, KeyEqual, Allocator>& rhs){
-		MySTL::swap(lhs.buckets_, rhs.buckets_);
+	template<class Key, class Hash, class KeyEqual, class Allocator, class BucketPolicy>
+	void swap(Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>& lhs,
+		Unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy>& rhs){
+		lhs.buckets_.swap(rhs.buckets_);
 		MySTL::swap(lhs.size_, rhs.size_);
 		MySTL::swap(lhs.max_load_factor_, rhs.max_load_factor_);
+		MySTL::swap(lhs.incremental_, rhs.incremental_);
+		lhs.old_buckets_.swap(rhs.old_buckets_);
+		MySTL::swap(lhs.migrate_index_, rhs.migrate_index_);
 	}
 }
 #endif
\ No newline at end of file
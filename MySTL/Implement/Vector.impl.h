@@ -58,7 +58,7 @@ namespace MySTL{
 
 	//*******************************************
 	template<class T, class Alloc>
-	void vector<T, Alloc>::resize(size_type n, value_type val = value_type()){
+	void vector<T, Alloc>::resize(size_type n, value_type val){
 		if (n < size()){
 			dataAllocator::destroy(start_ + n, finish_);
 			finish_ = start_ + n;
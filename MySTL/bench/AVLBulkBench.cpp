@@ -0,0 +1,74 @@
+#include "Bench.h"
+#include "AVLTree.h"
+
+#include <memory>
+#include <vector>
+
+// avl_tree bulk operations against one insert per value, at 10M values by default:
+// building from a sorted range, uniting the multiples of 2 with the multiples of 3
+// and intersecting them; the trees are rebuilt untimed before every run
+namespace{
+	using MySTL::Bench::keep;
+	using MySTL::Bench::report;
+	using MySTL::Bench::time_ms;
+
+	typedef MySTL::avl_tree<int> tree;
+
+	std::vector<int> multiples(int k, size_t n){
+		std::vector<int> res;
+		for (size_t v = 0; v < n; v += k)
+			res.push_back((int)v);
+		return res;
+	}
+}
+
+int main(int argc, char *argv[]){
+	const size_t n = MySTL::Bench::problem_size(argc, argv, 10000000);
+	char shape[32];
+	std::snprintf(shape, sizeof(shape), "n=%zu", n);
+	std::unique_ptr<tree> a, b;
+
+	const auto sorted = multiples(1, n);
+	report(shape, "build sorted", "insert each", time_ms([&]{ a.reset(); }, [&]{
+		a.reset(new tree);
+		for (auto v : sorted)
+			a->insert(v);
+		keep(a->size());
+	}, 1));
+	report(shape, "build sorted", "assign_sorted", time_ms([&]{ a.reset(); }, [&]{
+		a.reset(new tree);
+		a->assign_sorted(sorted.begin(), sorted.end());
+		keep(a->size());
+	}, 1));
+
+	const auto twos = multiples(2, n), threes = multiples(3, n);
+	auto rebuild = [&]{
+		a.reset(new tree);
+		a->assign_sorted(twos.begin(), twos.end());
+		b.reset(new tree);
+		b->assign_sorted(threes.begin(), threes.end());
+	};
+	report(shape, "union of 2k and 3k", "insert each", time_ms(rebuild, [&]{
+		for (auto it = b->cbegin(); it != b->cend(); ++it)
+			a->insert(*it);
+		keep(a->size());
+	}, 1));
+	report(shape, "union of 2k and 3k", "unite", time_ms(rebuild, [&]{
+		a->unite(*b);
+		keep(a->size());
+	}, 1));
+	report(shape, "intersect 2k and 3k", "find and insert each", time_ms(rebuild, [&]{
+		std::unique_ptr<tree> both(new tree);
+		for (auto it = b->cbegin(); it != b->cend(); ++it){
+			if (a->find(*it) != a->cend())
+				both->insert(*it);
+		}
+		a = std::move(both);
+		keep(a->size());
+	}, 1));
+	report(shape, "intersect 2k and 3k", "intersect", time_ms(rebuild, [&]{
+		a->intersect(*b);
+		keep(a->size());
+	}, 1));
+	return 0;
+}
\ No newline at end of file
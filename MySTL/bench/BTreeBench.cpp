@@ -0,0 +1,97 @@
+#include "Bench.h"
+#include "AVLTree.h"
+#include "BTree.h"
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+// btree_set against avl_tree and std::set on random ints: inserting n keys,
+// 1M lookups and 100K range scans of 64 values starting at lower_bound
+// the btree row names its node size, rebuild with -DBTREE_NODE_BYTES=128, 512 or
+// 1024 to compare: 128 bytes lost every row, 512 and 1024 found no faster than 256
+// and only won some of the scans, so 256 is the smallest node on the plateau
+namespace{
+	using MySTL::Bench::keep;
+	using MySTL::Bench::report;
+	using MySTL::Bench::time_ms;
+
+	const size_t lookups = 1000000;
+	const size_t scans = 100000;
+	const size_t scan_length = 64;
+
+	template<class Set, class Insert, class Lookup, class Scan>
+	void run(const char *shape, const char *impl, const std::vector<int>& keys, const std::vector<int>& queries,
+		Insert insert, Lookup lookup, Scan scan){
+		report(shape, "insert n", impl, time_ms([&]{
+			Set s;
+			for (auto k : keys)
+				insert(s, k);
+			keep(s.size());
+		}, 1));
+		Set s;
+		for (auto k : keys)
+			insert(s, k);
+		report(shape, "1M find", impl, time_ms([&]{
+			size_t hits = 0;
+			for (size_t i = 0; i != lookups; ++i)
+				hits += lookup(s, queries[i]);
+			keep(hits);
+		}));
+		report(shape, "100K scan of 64", impl, time_ms([&]{
+			size_t sum = 0;
+			for (size_t i = 0; i != scans; ++i)
+				sum += scan(s, queries[i]);
+			keep(sum);
+		}));
+	}
+}
+
+int main(int argc, char *argv[]){
+	const size_t largest = MySTL::Bench::problem_size(argc, argv, (size_t)1 << 23);
+	std::mt19937 gen(42);
+	std::vector<int> queries(lookups);
+
+	char shape[32], btree_name[32];
+	std::snprintf(btree_name, sizeof(btree_name), "MySTL::btree_set/%dB", (int)BTREE_NODE_BYTES);
+	for (size_t n = std::min((size_t)1 << 12, largest);; n = std::min(n << 4, largest)){
+		std::snprintf(shape, sizeof(shape), "n=%zu", n);
+		std::vector<int> keys(n);
+		for (auto& k : keys)
+			k = (int)(gen() >> 1);
+		for (size_t i = 0; i != lookups; ++i)//half of the lookups hit
+			queries[i] = (i & 1) ? keys[gen() % n] : (int)(gen() >> 1);
+
+		run<std::set<int>>(shape, "std::set", keys, queries,
+			[](std::set<int>& s, int k){ s.insert(k); },
+			[](const std::set<int>& s, int k){ return s.find(k) != s.end() ? 1 : 0; },
+			[](const std::set<int>& s, int k){
+				size_t sum = 0, i = 0;
+				for (auto it = s.lower_bound(k); it != s.end() && i != scan_length; ++it, ++i)
+					sum += *it;
+				return sum;
+			});
+		run<MySTL::avl_tree<int>>(shape, "MySTL::avl_tree", keys, queries,
+			[](MySTL::avl_tree<int>& s, int k){ s.insert(k); },
+			[](const MySTL::avl_tree<int>& s, int k){ return s.find(k) != s.cend() ? 1 : 0; },
+			[](const MySTL::avl_tree<int>& s, int k){
+				size_t sum = 0, i = 0;
+				for (auto it = s.lower_bound(k); it != s.cend() && i != scan_length; ++it, ++i)
+					sum += *it;
+				return sum;
+			});
+		run<MySTL::btree_set<int>>(shape, btree_name, keys, queries,
+			[](MySTL::btree_set<int>& s, int k){ s.insert(k); },
+			[](const MySTL::btree_set<int>& s, int k){ return s.find(k) != s.end() ? 1 : 0; },
+			[](const MySTL::btree_set<int>& s, int k){
+				size_t sum = 0, i = 0;
+				for (auto it = s.lower_bound(k); it != s.end() && i != scan_length; ++it, ++i)
+					sum += *it;
+				return sum;
+			});
+		if (n == largest)
+			break;
+	}
+	return 0;
+}
\ No newline at end of file
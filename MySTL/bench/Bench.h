@@ -0,0 +1,59 @@
+#ifndef _BENCH_H_
+#define _BENCH_H_
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+// helpers shared by the benchmark drivers in this folder
+// every driver is a standalone program, build it with Header and Implement on
+// the include path, the non-template sources linked in and optimizations on, e.g.
+//     g++ -std=c++17 -O2 -pthread -I../Header -I../Implement UnorderedMapBench.cpp ../Implement/*.cpp
+namespace MySTL{
+	namespace Bench{
+		// best wall time of reps runs of f, in milliseconds, setup() runs untimed
+		// before each of them
+		template<class Setup, class F>
+		double time_ms(Setup setup, F f, int reps = 3){
+			double best = 0;
+			for (int i = 0; i != reps; ++i){
+				setup();
+				auto start = std::chrono::steady_clock::now();
+				f();
+				auto stop = std::chrono::steady_clock::now();
+				double ms = std::chrono::duration<double, std::milli>(stop - start).count();
+				if (i == 0 || ms < best)
+					best = ms;
+			}
+			return best;
+		}
+		template<class F>
+		double time_ms(F f, int reps = 3){
+			return time_ms([]{}, f, reps);
+		}
+		inline void report(const char *shape, const char *op, const char *impl, double ms){
+			std::printf("%-16s %-22s %-26s %10.2f ms\n", shape, op, impl, ms);
+		}
+		// a latency of one operation, in nanoseconds
+		inline void report_ns(const char *shape, const char *op, const char *impl, double ns){
+			std::printf("%-16s %-22s %-26s %10.0f ns\n", shape, op, impl, ns);
+		}
+		// keep the optimizer from dropping a result
+		inline void keep(size_t v){
+			static volatile size_t sink;
+			sink = v;
+		}
+		// v read back from a volatile, so a loop that repeats work on it can't hoist it
+		template<class T>
+		inline T opaque(T v){
+			volatile T copy = v;
+			return copy;
+		}
+		// the problem size, argv[1] if given
+		inline size_t problem_size(int argc, char *argv[], size_t n){
+			return argc > 1 ? (size_t)std::strtoull(argv[1], 0, 10) : n;
+		}
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include "Bench.h"
+#include "Unordered_set.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// lookup cost of the Unordered_set bucket policies on random 64-bit keys, from
+// 1K keys that stay in L1 up to 4M by default: latency chains every lookup on
+// the result of the one before so the division of prime_bucket_policy is paid in
+// full, throughput lets the lookups overlap
+namespace{
+	using MySTL::Bench::keep;
+	using MySTL::Bench::report_ns;
+	using MySTL::Bench::time_ms;
+
+	const size_t lookups = 4000000;
+
+	template<class Policy>
+	void run(const char *shape, const char *impl, const std::vector<unsigned long long>& keys){
+		typedef MySTL::Unordered_set<unsigned long long, std::hash<unsigned long long>,
+			MySTL::equal_to<unsigned long long>, MySTL::allocator<unsigned long long>, Policy> set_type;
+		set_type s(keys.size());
+		s.insert(keys.data(), keys.data() + keys.size());
+		const size_t mask = keys.size() - 1;
+		report_ns(shape, "find latency", impl, time_ms([&]{
+			size_t i = 0;
+			for (size_t n = 0; n != lookups; ++n)
+				i = ((size_t)*s.find(keys[i]) + n) & mask;//n keeps the walk out of short cycles
+			keep(i);
+		}) * 1e6 / lookups);
+		report_ns(shape, "find throughput", impl, time_ms([&]{
+			size_t sum = 0;
+			for (size_t n = 0; n != lookups; ++n)
+				sum += *s.find(keys[(n * 0x9E3779B97F4A7C15ull >> 7) & mask]);
+			keep(sum);
+		}) * 1e6 / lookups);
+	}
+}
+
+int main(int argc, char *argv[]){
+	const size_t largest = MySTL::Bench::problem_size(argc, argv, (size_t)1 << 22);
+	std::mt19937_64 gen(42);
+	char shape[32];
+	for (size_t n = std::min((size_t)1 << 10, largest);; n = std::min(n << 2, largest)){
+		std::snprintf(shape, sizeof(shape), "n=%zu", n);
+		std::vector<unsigned long long> keys(n);
+		for (auto& k : keys)
+			k = gen();
+		run<MySTL::prime_bucket_policy>(shape, "prime, hash % count", keys);
+		run<MySTL::fastrange_bucket_policy>(shape, "prime, fast range", keys);
+		run<MySTL::power2_bucket_policy>(shape, "power of two, mixed", keys);
+		if (n == largest)
+			break;
+	}
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include "Bench.h"
+#include "Concurrent_unordered_set.h"
+#include "Unordered_set.h"
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// concurrent_unordered_set against one Unordered_set behind a global mutex,
+// 1 to 32 threads share a fixed number of operations on a preloaded set
+// read-heavy is 90% count, 5% insert, 5% erase, write-heavy is 50/25/25
+// build with -pthread where needed
+namespace{
+	using MySTL::Bench::keep;
+	using MySTL::Bench::report;
+	using MySTL::Bench::time_ms;
+
+	const unsigned KEY_RANGE = 1 << 20;
+
+	struct locked_set{
+		std::mutex mutex_;
+		MySTL::Unordered_set<unsigned> set_;
+		locked_set() :set_(KEY_RANGE){}
+		size_t count(unsigned key){ std::lock_guard<std::mutex> guard(mutex_); return set_.count(key); }
+		bool insert(unsigned key){ std::lock_guard<std::mutex> guard(mutex_); return set_.insert(key).second; }
+		size_t erase(unsigned key){ std::lock_guard<std::mutex> guard(mutex_); return set_.erase(key); }
+	};
+	struct sharded_set{
+		MySTL::concurrent_unordered_set<unsigned> set_;
+		explicit sharded_set(size_t shards) :set_(KEY_RANGE, shards){}
+		size_t count(unsigned key){ return set_.count(key); }
+		bool insert(unsigned key){ return set_.insert(key); }
+		size_t erase(unsigned key){ return set_.erase(key); }
+	};
+
+	// ops operations with reads out of 100 being lookups, the rest split between
+	// insert and erase so the size stays about the same
+	template<class Set>
+	size_t worker(Set& set, size_t ops, unsigned reads, unsigned seed){
+		size_t hits = 0;
+		unsigned x = seed * 2654435761u + 1;
+		for (size_t i = 0; i != ops; ++i){
+			x ^= x << 13; x ^= x >> 17; x ^= x << 5;//xorshift32
+			unsigned key = x & (KEY_RANGE - 1), dice = (x >> 20) % 100;
+			if (dice < reads)
+				hits += set.count(key);
+			else if ((dice - reads) % 2 == 0)
+				hits += set.insert(key);
+			else
+				hits += set.erase(key);
+		}
+		return hits;
+	}
+	template<class Set>
+	void run(const char *shape, const char *impl, Set& set, size_t ops, unsigned reads){
+		for (unsigned i = 0; i < KEY_RANGE; i += 2)
+			set.insert(i);
+		for (size_t threads = 1; threads <= 32; threads *= 2){
+			char label[32];
+			std::snprintf(label, sizeof(label), "%d threads", (int)threads);
+			report(shape, label, impl, time_ms([&]{
+				std::vector<std::thread> pool;
+				for (size_t t = 0; t != threads; ++t)
+					pool.push_back(std::thread([&, t]{ keep(worker(set, ops / threads, reads, (unsigned)t + 1)); }));
+				for (auto& th : pool)
+					th.join();
+			}));
+		}
+	}
+	void run_all(const char *shape, size_t ops, unsigned reads){
+		{
+			locked_set set;
+			run(shape, "Unordered_set+mutex", set, ops, reads);
+		}
+		{
+			sharded_set set(16);
+			run(shape, "concurrent/16 shards", set, ops, reads);
+		}
+		{
+			sharded_set set(64);
+			run(shape, "concurrent/64 shards", set, ops, reads);
+		}
+	}
+}
+
+int main(int argc, char *argv[]){
+	size_t ops = MySTL::Bench::problem_size(argc, argv, 4000000);
+	run_all("read-heavy", ops, 90);
+	run_all("write-heavy", ops, 50);
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include "Bench.h"
+#include "Unordered_set.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Unordered_set::find_batch and contains_batch against a loop of find on random
+// 64-bit keys, half of them present, from 64K keys up to 16M by default, which
+// with the nodes and the bucket heads is about 400MB, past the last level cache;
+// the batched calls get the keys 4096 at a time
+namespace{
+	using MySTL::Bench::keep;
+	using MySTL::Bench::report;
+	using MySTL::Bench::time_ms;
+
+	typedef MySTL::Unordered_set<unsigned long long> set_type;
+	const size_t lookups = 4000000;
+	const size_t chunk = 4096;
+}
+
+int main(int argc, char *argv[]){
+	const size_t largest = MySTL::Bench::problem_size(argc, argv, (size_t)1 << 24);
+	std::mt19937_64 gen(42);
+	std::vector<unsigned long long> queries(lookups);
+	std::vector<set_type::iterator> found(chunk);
+	std::unique_ptr<bool[]> present(new bool[chunk]);
+	char shape[32];
+	for (size_t n = std::min((size_t)1 << 16, largest);; n = std::min(n << 2, largest)){
+		std::snprintf(shape, sizeof(shape), "n=%zu", n);
+		std::vector<unsigned long long> keys(n);
+		for (auto& k : keys)
+			k = gen() | 1;//odd keys are present, even ones miss
+		set_type s(n);
+		s.insert(keys.data(), keys.data() + n);
+		for (size_t i = 0; i != lookups; ++i)
+			queries[i] = (i & 1) ? keys[gen() % n] : gen() & ~1ull;
+
+		report(shape, "4M lookups", "loop of find", time_ms([&]{
+			size_t hits = 0;
+			for (auto q : queries)
+				hits += (s.find(q) != s.end());
+			keep(hits);
+		}));
+		report(shape, "4M lookups", "find_batch", time_ms([&]{
+			size_t hits = 0;
+			for (size_t i = 0; i < lookups; i += chunk){
+				auto m = std::min(chunk, lookups - i);
+				s.find_batch(queries.data() + i, m, found.data());
+				for (size_t j = 0; j != m; ++j)
+					hits += (found[j] != s.end());
+			}
+			keep(hits);
+		}));
+		report(shape, "4M lookups", "contains_batch", time_ms([&]{
+			size_t hits = 0;
+			for (size_t i = 0; i < lookups; i += chunk){
+				auto m = std::min(chunk, lookups - i);
+				s.contains_batch(queries.data() + i, m, present.get());
+				for (size_t j = 0; j != m; ++j)
+					hits += present[j];
+			}
+			keep(hits);
+		}));
+		if (n == largest)
+			break;
+	}
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+#include "Bench.h"
+#include "AVLTree.h"
+#include "Concurrent_ordered_set.h"
+
+#include <atomic>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+// read throughput of concurrent_ordered_set against an avl_tree behind a
+// std::shared_mutex: 1 to 4 reader threads share a fixed number of lookups on 1M
+// preloaded keys while 0 to 2 writer threads insert and erase other keys
+// for as long as the readers run
+namespace{
+	using MySTL::Bench::keep;
+	using MySTL::Bench::report;
+	using MySTL::Bench::time_ms;
+
+	const unsigned KEY_RANGE = 1 << 21;// the even keys are preloaded, the writers use the odd ones
+
+	struct locked_tree{
+		mutable std::shared_mutex mutex_;
+		MySTL::avl_tree<unsigned> tree_;
+		size_t count(unsigned key)const{ std::shared_lock<std::shared_mutex> guard(mutex_); return tree_.find(key) != tree_.cend(); }
+		void insert(unsigned key){ std::unique_lock<std::shared_mutex> guard(mutex_); tree_.insert(key); }
+		void erase(unsigned key){ std::unique_lock<std::shared_mutex> guard(mutex_); tree_.erase(key); }
+	};
+	struct skiplist{
+		MySTL::concurrent_ordered_set<unsigned> set_;
+		size_t count(unsigned key)const{ return set_.count(key); }
+		void insert(unsigned key){ set_.insert(key); }
+		void erase(unsigned key){ set_.erase(key); }
+	};
+
+	unsigned next_key(unsigned& x){
+		x ^= x << 13; x ^= x >> 17; x ^= x << 5;//xorshift32
+		return x & (KEY_RANGE - 1);
+	}
+	template<class Set>
+	void run(const char *impl, Set& set, size_t lookups){
+		for (unsigned i = 0; i < KEY_RANGE; i += 2)
+			set.insert(i);
+		for (size_t writers = 0; writers <= 2; ++writers){
+			for (size_t readers = 1; readers <= 4; readers *= 2){
+				char shape[32], op[32];
+				std::snprintf(shape, sizeof(shape), "%d writers", (int)writers);
+				std::snprintf(op, sizeof(op), "%d readers", (int)readers);
+				std::atomic<size_t> writes(0);
+				report(shape, op, impl, time_ms([&]{ writes = 0; }, [&]{
+					std::atomic<bool> done(false);
+					std::vector<std::thread> pool;
+					for (size_t t = 0; t != writers; ++t){
+						pool.push_back(std::thread([&, t]{
+							unsigned x = (unsigned)t * 2654435761u + 7;
+							size_t n = 0;
+							for (; !done.load(std::memory_order_relaxed); ++n){
+								auto key = next_key(x) | 1;
+								if (n & 1)
+									set.erase(key);
+								else
+									set.insert(key);
+							}
+							writes += n;
+						}));
+					}
+					std::vector<std::thread> reading;
+					for (size_t t = 0; t != readers; ++t){
+						reading.push_back(std::thread([&, t]{
+							unsigned x = (unsigned)t * 2246822519u + 1;
+							size_t hits = 0;
+							for (size_t i = 0; i != lookups / readers; ++i)
+								hits += set.count(next_key(x));
+							keep(hits);
+						}));
+					}
+					for (auto& th : reading)
+						th.join();
+					done = true;
+					for (auto& th : pool)
+						th.join();
+				}));
+				if (writers != 0)//done alongside the last, fastest run
+					std::printf("%-16s %-22s %-26s %10zu writes\n", shape, op, impl, writes.load());
+			}
+		}
+	}
+}
+
+int main(int argc, char *argv[]){
+	const size_t lookups = MySTL::Bench::problem_size(argc, argv, 4000000);
+	{
+		locked_tree set;
+		run("avl_tree+shared_mutex", set, lookups);
+	}
+	{
+		skiplist set;
+		run("concurrent_ordered_set", set, lookups);
+	}
+	return 0;
+}
\ No newline at end of file
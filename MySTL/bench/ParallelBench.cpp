@@ -0,0 +1,141 @@
+#include "Bench.h"
+#include "ParallelAlgorithm.h"
+
+#include <atomic>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// every parallel algorithm under seq, par and par_unseq for n from 2^10 up, and the
+// smallest n from which par stays ahead of seq; the grains of ParallelAlgorithm.impl.h
+// are checked against the cost of one task and the cost of one item of each algorithm:
+// a chunk of grain items should take ten times as long as handing it to a worker
+// usage: ParallelBench [largest n] [workers, the default pool if not given]
+namespace{
+	using MySTL::Bench::keep;
+	using MySTL::Bench::report;
+	using MySTL::Bench::time_ms;
+	namespace ex = MySTL::execution;
+
+	struct sweep_result{
+		std::vector<size_t> sizes;
+		std::vector<double> seq, par;
+	};
+
+	// body(policy, n) runs the algorithm on the first n items, setup(n) restores them
+	template<class Setup, class Body>
+	sweep_result sweep(const char *op, size_t largest, const ex::parallel_policy& par, Setup setup, Body body){
+		sweep_result res;
+		char shape[32];
+		for (size_t n = 1 << 10; n <= largest; n <<= 2){
+			std::snprintf(shape, sizeof(shape), "n=%zu", n);
+			const int reps = n < (1 << 20) ? 9 : 3;
+			const double seq = time_ms([&]{ setup(n); }, [&]{ body(ex::seq, n); }, reps);
+			const double p = time_ms([&]{ setup(n); }, [&]{ body(par, n); }, reps);
+			const double pu = time_ms([&]{ setup(n); }, [&]{ body(ex::par_unseq.on(par.pool()), n); }, reps);
+			report(shape, op, "seq", seq);
+			report(shape, op, "par", p);
+			report(shape, op, "par_unseq", pu);
+			res.sizes.push_back(n);
+			res.seq.push_back(seq);
+			res.par.push_back(p);
+		}
+		return res;
+	}
+	// the smallest size from which par beats seq by 5% at every larger size, 0 if none
+	size_t break_even(const sweep_result& res){
+		size_t even = 0;
+		for (size_t i = res.sizes.size(); i-- != 0;){
+			if (res.par[i] >= 0.95 * res.seq[i])
+				break;
+			even = res.sizes[i];
+		}
+		return even;
+	}
+	// nanoseconds from submitting an empty task until a worker has run it, the cost
+	// a chunk pays on top of its items: the queue locks, waking a worker and the join;
+	// without workers it is the cost of queueing the task and running it in place
+	double task_ns(MySTL::thread_pool& pool){
+		const int tasks = 10000;
+		const double ms = time_ms([&]{
+			for (int i = 0; i != tasks; ++i){
+				std::atomic<bool> done(false);
+				pool.submit([&done]{ done.store(true, std::memory_order_release); });
+				if (pool.size() == 0)
+					pool.run_one();
+				while (!done.load(std::memory_order_acquire))
+					std::this_thread::yield();
+			}
+		});
+		return ms * 1e6 / tasks;
+	}
+	// the smallest power of two chunk that costs ten tasks
+	size_t suggested_grain(double task, double item){
+		size_t grain = 1;
+		while ((double)grain * item < 10 * task)
+			grain <<= 1;
+		return grain;
+	}
+	void summary(const char *op, const sweep_result& res, double task, long long grain, size_t workers){
+		const double item = res.seq.back() * 1e6 / (double)res.sizes.back();
+		const size_t even = break_even(res);
+		std::string line = workers == 0 ? "no workers, par is seq" :
+			even ? "break-even n=" + std::to_string(even) : "par never ahead";
+		std::printf("%-16s %-22s %-26s %s, %.2f ns/item, grain %lld, suggested %zu\n", "summary", op,
+			line.c_str(), "seq", item, grain, suggested_grain(task, item));
+	}
+}
+
+int main(int argc, char *argv[]){
+	const size_t largest = MySTL::Bench::problem_size(argc, argv, 1 << 24);
+	MySTL::thread_pool *own = argc > 2 ? new MySTL::thread_pool((size_t)std::strtoull(argv[2], 0, 10)) : 0;
+	MySTL::thread_pool& pool = own ? *own : MySTL::thread_pool::default_pool();
+	const ex::parallel_policy par = ex::par.on(pool);
+	std::printf("%zu workers besides the caller\n", pool.size());
+
+	std::mt19937 gen(42);
+	std::vector<int> data(largest), work(largest), out(largest);
+	for (auto& x : data)
+		x = (int)(gen() >> 1);
+	auto restore = [&](size_t n){ std::memcpy(work.data(), data.data(), n * sizeof(int)); };
+	auto nothing = [](size_t){};
+	int *w = work.data(), *o = out.data();
+
+	const double task = task_ns(pool);
+	MySTL::Bench::report_ns("task", "hand over and run", "empty task", task);
+
+	restore(largest);
+	auto r_for_each = sweep("for_each", largest, par, nothing, [&](const auto& policy, size_t n){
+		MySTL::for_each(policy, w, w + n, [](int& x){ x = x * 3 + 1; });
+	});
+	auto r_find_if = sweep("find_if (miss)", largest, par, nothing, [&](const auto& policy, size_t n){
+		keep(MySTL::find_if(policy, w, w + n, [](int x){ return x == -1; }) - w);
+	});
+	auto r_count_if = sweep("count_if", largest, par, nothing, [&](const auto& policy, size_t n){
+		keep((size_t)MySTL::count_if(policy, w, w + n, [](int x){ return (x & 3) == 0; }));
+	});
+	auto r_fill = sweep("fill", largest, par, nothing, [&](const auto& policy, size_t n){
+		MySTL::fill(policy, w, w + n, 7);
+	});
+	auto r_copy = sweep("copy", largest, par, nothing, [&](const auto& policy, size_t n){
+		MySTL::copy(policy, w, w + n, o);
+	});
+	auto r_generate = sweep("generate", largest, par, nothing, [&](const auto& policy, size_t n){
+		MySTL::generate(policy, w, w + n, []{ return 11; });
+	});
+	auto r_sort = sweep("sort", largest, par, restore, [&](const auto& policy, size_t n){
+		MySTL::sort(policy, w, w + n);
+	});
+
+	summary("for_each", r_for_each, task, (long long)MySTL::Detail::PARALLEL_GRAIN, pool.size());
+	summary("find_if (miss)", r_find_if, task, (long long)MySTL::Detail::PARALLEL_GRAIN, pool.size());
+	summary("count_if", r_count_if, task, (long long)MySTL::Detail::PARALLEL_GRAIN, pool.size());
+	summary("fill", r_fill, task, (long long)MySTL::Detail::PARALLEL_COPY_GRAIN, pool.size());
+	summary("copy", r_copy, task, (long long)MySTL::Detail::PARALLEL_COPY_GRAIN, pool.size());
+	summary("generate", r_generate, task, (long long)MySTL::Detail::PARALLEL_GRAIN, pool.size());
+	summary("sort", r_sort, task, (long long)MySTL::Detail::PARALLEL_SORT_GRAIN, pool.size());
+	delete own;
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#include "Bench.h"
+#include "ParallelAlgorithm.h"
+
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
+// parallel_sort of random ints on pools of 1 up to hardware_concurrency() threads, the
+// calling thread included, with the speedup over one thread; every sort is one run,
+// each of them already takes seconds at the default 100M items
+namespace{
+	using MySTL::Bench::report;
+	using MySTL::Bench::time_ms;
+}
+
+int main(int argc, char *argv[]){
+	const size_t n = MySTL::Bench::problem_size(argc, argv, 100000000);
+	std::vector<int> data(n);
+	auto refill = [&]{
+		std::mt19937 gen(42);
+		for (auto& x : data)
+			x = (int)gen();
+	};
+	report("random int", "sort", "std::sort", time_ms(refill, [&]{ std::sort(data.begin(), data.end()); }, 1));
+
+	const size_t most = std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 1;
+	double one = 0;
+	char impl[64];
+	for (size_t threads = 1; threads <= most; threads = (threads == most || threads * 2 < most) ? threads * 2 : most){
+		MySTL::thread_pool pool(threads - 1);
+		const double ms = time_ms(refill, [&]{
+			MySTL::parallel_sort(data.data(), data.data() + n, MySTL::less<int>(), pool);
+		}, 1);
+		if (threads == 1)
+			one = ms;
+		std::snprintf(impl, sizeof(impl), "%zu threads, x%.2f", threads, one / ms);
+		report("random int", "parallel_sort", impl, ms);
+		if (!std::is_sorted(data.begin(), data.end()))
+			std::printf("not sorted!\n");
+	}
+	return 0;
+}
\ No newline at end of file
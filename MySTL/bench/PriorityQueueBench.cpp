@@ -0,0 +1,41 @@
+#include "Bench.h"
+#include "Queue.h"
+
+#include <queue>
+#include <random>
+#include <vector>
+
+// push n random ints into a priority_queue and pop them all, std::priority_queue
+// against MySTL::priority_queue on a binary and on a 4-ary heap
+namespace{
+	using MySTL::Bench::keep;
+	using MySTL::Bench::report;
+	using MySTL::Bench::time_ms;
+
+	template<class Queue>
+	void run(const char *impl, const std::vector<int>& input){
+		report("random", "push all, pop all", impl, time_ms([&]{
+			Queue q;
+			for (auto x : input)
+				q.push(x);
+			size_t sum = 0;
+			while (!q.empty()){
+				sum += q.top();
+				q.pop();
+			}
+			keep(sum);
+		}));
+	}
+}
+
+int main(int argc, char *argv[]){
+	size_t n = MySTL::Bench::problem_size(argc, argv, 10000000);
+	std::mt19937 gen(42);
+	std::vector<int> input(n);
+	for (auto& x : input)
+		x = (int)(gen() >> 1);
+	run<std::priority_queue<int>>("std::priority_queue", input);
+	run<MySTL::priority_queue<int>>("MySTL::priority_queue", input);
+	run<MySTL::priority_queue<int, MySTL::vector<int>, MySTL::less<int>, 4>>("MySTL::priority_queue/4", input);
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#include "Bench.h"
+#include "Unordered_set.h"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+// tail latency of single inserts while the table grows: a stop-the-world rehash
+// shows up at p99.9 and max, the incremental one spreads it over the next inserts
+namespace{
+	using MySTL::Bench::keep;
+	using MySTL::Bench::report_ns;
+
+	template<class Set>
+	void run(const char *impl, Set& set, const std::vector<unsigned long long>& keys){
+		std::vector<double> ns(keys.size());
+		for (size_t i = 0; i != keys.size(); ++i){
+			auto start = std::chrono::steady_clock::now();
+			set.insert(keys[i]);
+			auto stop = std::chrono::steady_clock::now();
+			ns[i] = std::chrono::duration<double, std::nano>(stop - start).count();
+		}
+		keep(set.size());
+		std::sort(ns.begin(), ns.end());
+		report_ns("insert", "p50", impl, ns[ns.size() / 2]);
+		report_ns("insert", "p99", impl, ns[ns.size() * 99 / 100]);
+		report_ns("insert", "p99.9", impl, ns[ns.size() * 999 / 1000]);
+		report_ns("insert", "max", impl, ns.back());
+	}
+}
+
+int main(int argc, char *argv[]){
+	size_t n = MySTL::Bench::problem_size(argc, argv, 4000000);
+	std::mt19937_64 gen(42);
+	std::vector<unsigned long long> keys(n);
+	for (auto& k : keys)
+		k = gen();
+
+	std::unordered_set<unsigned long long> s;
+	run("std::unordered_set", s, keys);
+	MySTL::Unordered_set<unsigned long long> all(16);
+	run("MySTL::Unordered_set", all, keys);
+	MySTL::Unordered_set<unsigned long long> inc(16);
+	inc.incremental_rehash(true);
+	run("MySTL::Unordered_set/incr", inc, keys);
+	return 0;
+}
\ No newline at end of file
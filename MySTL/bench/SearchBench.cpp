@@ -0,0 +1,55 @@
+#include "Bench.h"
+#include "EytzingerArray.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// lower_bound of random keys in sorted ints: std::lower_bound, the branchless
+// MySTL::lower_bound and eytzinger_array, from 1K items up to an array larger than
+// the last level cache (the default 2^27 ints is 512MB)
+namespace{
+	using MySTL::Bench::keep;
+	using MySTL::Bench::report;
+	using MySTL::Bench::time_ms;
+}
+
+int main(int argc, char *argv[]){
+	const size_t largest = MySTL::Bench::problem_size(argc, argv, (size_t)1 << 27);
+	const size_t lookups = 4000000;
+	std::mt19937 gen(42);
+	std::vector<int> queries(lookups);
+	for (auto& q : queries)
+		q = (int)(gen() >> 1);
+
+	char shape[32];
+	for (size_t n = std::min((size_t)1 << 10, largest);; n = std::min(n << 3, largest)){
+		std::snprintf(shape, sizeof(shape), "n=%zu", n);
+		std::vector<int> sorted(n);
+		for (size_t i = 0; i != n; ++i)//even values spread over the range of the queries
+			sorted[i] = (int)((0x7fffffffull * i / n) & ~1ull);
+		const int *first = sorted.data(), *last = first + n;
+		report(shape, "4M lower_bound", "std::lower_bound", time_ms([&]{
+			size_t sum = 0;
+			for (auto q : queries)
+				sum += std::lower_bound(first, last, q) - first;
+			keep(sum);
+		}));
+		report(shape, "4M lower_bound", "MySTL::lower_bound", time_ms([&]{
+			size_t sum = 0;
+			for (auto q : queries)
+				sum += MySTL::lower_bound(first, last, q) - first;
+			keep(sum);
+		}));
+		MySTL::eytzinger_array<int> eytz(first, last);
+		report(shape, "4M lower_bound", "MySTL::eytzinger_array", time_ms([&]{
+			size_t sum = 0;
+			for (auto q : queries)
+				sum += eytz.lower_bound(q) - eytz.begin();
+			keep(sum);
+		}));
+		if (n == largest)
+			break;
+	}
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "Bench.h"
+#include "Algorithm.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// the SIMD scans of Algorithm.h (find, count, mismatch, equal and search over pointers
+// to integers) against std's on 1K to 100M items of 1 and 4 bytes, in nanoseconds per
+// scan: the items are random in [1, 64], find looks for the absent 0, count for a value
+// that is one item in 64, mismatch and equal compare two equal copies and search looks
+// for 8 items whose first one starts a candidate every 64 items or so
+namespace{
+	using MySTL::Bench::keep;
+	using MySTL::Bench::opaque;
+	using MySTL::Bench::report_ns;
+	using MySTL::Bench::time_ms;
+
+	template<class T>
+	void run(const char *type, size_t largest){
+		std::mt19937 gen(42);
+		std::vector<T> a(largest), b, pattern(8);
+		for (auto& x : a)
+			x = (T)(1 + gen() % 64);
+		b = a;
+		for (auto& x : pattern)
+			x = (T)(1 + gen() % 64);
+		const T *p = a.data(), *q = b.data(), *s = pattern.data();
+		char shape[32];
+		for (size_t n = std::min((size_t)1000, largest);; n = std::min(n * 10, largest)){
+			std::snprintf(shape, sizeof(shape), "%s n=%zu", type, n);
+			const size_t scans = std::max((size_t)1, (size_t)100000000 / n);//about 100M items a timing
+			auto time = [&](const char *op, const char *impl, size_t(*scan)(const T *, const T *, const T *, size_t)){
+				const double ms = time_ms([&]{
+					size_t sum = 0;
+					for (size_t i = 0; i != scans; ++i)
+						sum += scan(opaque(p), q, s, n);
+					keep(sum);
+				});
+				report_ns(shape, op, impl, ms * 1e6 / (double)scans);
+			};
+			time("find", "std::find", [](const T *p, const T *, const T *, size_t n)->size_t{
+				return std::find(p, p + n, (T)0) - p;
+			});
+			time("find", "MySTL::find", [](const T *p, const T *, const T *, size_t n)->size_t{
+				return MySTL::find(p, p + n, (T)0) - p;
+			});
+			time("count", "std::count", [](const T *p, const T *, const T *, size_t n)->size_t{
+				return (size_t)std::count(p, p + n, (T)7);
+			});
+			time("count", "MySTL::count", [](const T *p, const T *, const T *, size_t n)->size_t{
+				return (size_t)MySTL::count(p, p + n, (T)7);
+			});
+			time("mismatch", "std::mismatch", [](const T *p, const T *q, const T *, size_t n)->size_t{
+				return std::mismatch(p, p + n, q).first - p;
+			});
+			time("mismatch", "MySTL::mismatch", [](const T *p, const T *q, const T *, size_t n)->size_t{
+				return MySTL::mismatch(p, p + n, q).first - p;
+			});
+			time("equal", "std::equal", [](const T *p, const T *q, const T *, size_t n)->size_t{
+				return std::equal(p, p + n, q);
+			});
+			time("equal", "MySTL::equal", [](const T *p, const T *q, const T *, size_t n)->size_t{
+				return MySTL::equal(p, p + n, q);
+			});
+			time("search", "std::search", [](const T *p, const T *, const T *s, size_t n)->size_t{
+				return std::search(p, p + n, s, s + 8) - p;
+			});
+			time("search", "MySTL::search", [](const T *p, const T *, const T *s, size_t n)->size_t{
+				return MySTL::search(p, p + n, s, s + 8) - p;
+			});
+			if (n == largest)
+				break;
+		}
+	}
+}
+
+int main(int argc, char *argv[]){
+	const size_t largest = MySTL::Bench::problem_size(argc, argv, 100000000);
+	run<uint8_t>("u8", largest);
+	run<uint32_t>("u32", largest);
+	return 0;
+}
\ No newline at end of file
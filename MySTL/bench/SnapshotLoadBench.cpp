@@ -0,0 +1,112 @@
+#include "Bench.h"
+#include "HashSnapshot.h"
+#include "Unordered_set.h"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+// startup cost of a hash set of 4M keys by default, 64-bit ints and strings of 8 to
+// 24 chars: rebuilding an Unordered_set from a text file of one key per line,
+// against opening a snapshot of it, which maps the file and checks every offset
+// and entry, then 1M lookups in each; the files are written to the current
+// folder, removed at the end and read while in the page cache
+namespace{
+	using MySTL::Bench::keep;
+	using MySTL::Bench::report;
+	using MySTL::Bench::time_ms;
+
+	const char *TEXT_PATH = "snapshot_bench.txt";
+	const char *SNAPSHOT_PATH = "snapshot_bench.snap";
+	const size_t lookups = 1000000;
+
+	struct string_hash{// FNV-1a
+		size_t operator()(const MySTL::string& s)const{
+			unsigned long long h = 14695981039346656037ull;
+			for (auto c : s)
+				h = (h ^ (unsigned char)c) * 1099511628211ull;
+			return (size_t)h;
+		}
+	};
+
+	unsigned long long parse(const char *line, unsigned long long*){ return std::strtoull(line, 0, 10); }
+	MySTL::string parse(const char *line, MySTL::string*){
+		auto len = std::strlen(line);
+		return MySTL::string(line, len != 0 && line[len - 1] == '\n' ? len - 1 : len);
+	}
+	void print(FILE *file, unsigned long long key){ std::fprintf(file, "%llu\n", key); }
+	void print(FILE *file, const MySTL::string& key){ std::fwrite(key.begin(), 1, key.size(), file); std::fputc('\n', file); }
+
+	template<class Key, class Hash>
+	void run(const char *shape, const std::vector<Key>& keys, const std::vector<Key>& queries){
+		typedef MySTL::Unordered_set<Key, Hash> set_type;
+		FILE *text = std::fopen(TEXT_PATH, "w");
+		for (auto& k : keys)
+			print(text, k);
+		std::fclose(text);
+		{
+			set_type s(16);
+			for (auto& k : keys)
+				s.insert(k);
+			if (!MySTL::write_snapshot(s, SNAPSHOT_PATH)){
+				std::printf("can not write %s\n", SNAPSHOT_PATH);
+				return;
+			}
+		}
+		set_type *loaded = 0;
+		report(shape, "load", "Unordered_set from text", time_ms([&]{ delete loaded; loaded = 0; }, [&]{
+			loaded = new set_type(16);
+			char line[64];
+			FILE *file = std::fopen(TEXT_PATH, "r");
+			while (std::fgets(line, sizeof(line), file))
+				loaded->insert(parse(line, (Key *)0));
+			std::fclose(file);
+			keep(loaded->size());
+		}));
+		report(shape, "1M lookups", "Unordered_set from text", time_ms([&]{
+			size_t hits = 0;
+			for (size_t i = 0; i != lookups; ++i)
+				hits += loaded->count(queries[i]);
+			keep(hits);
+		}));
+		delete loaded;
+		MySTL::hash_set_snapshot<Key, Hash> snap;
+		report(shape, "load", "hash_set_snapshot::open", time_ms([&]{ snap.close(); }, [&]{
+			keep(snap.open(SNAPSHOT_PATH) ? snap.size() : 0);
+		}));
+		report(shape, "1M lookups", "hash_set_snapshot::open", time_ms([&]{
+			size_t hits = 0;
+			for (size_t i = 0; i != lookups; ++i)
+				hits += snap.count(queries[i]);
+			keep(hits);
+		}));
+		snap.close();
+		std::remove(TEXT_PATH);
+		std::remove(SNAPSHOT_PATH);
+	}
+}
+
+int main(int argc, char *argv[]){
+	const size_t n = MySTL::Bench::problem_size(argc, argv, 4000000);
+	std::mt19937_64 gen(42);
+
+	std::vector<unsigned long long> ints(n), int_queries(lookups);
+	for (auto& k : ints)
+		k = gen();
+	for (size_t i = 0; i != lookups; ++i)//half of the lookups hit
+		int_queries[i] = (i & 1) ? ints[gen() % n] : gen();
+	run<unsigned long long, std::hash<unsigned long long>>("u64", ints, int_queries);
+
+	std::vector<MySTL::string> strs(n), str_queries(lookups);
+	for (auto& s : strs){
+		char buf[32];
+		size_t len = 8 + gen() % 17;
+		for (size_t i = 0; i != len; ++i)
+			buf[i] = (char)('a' + gen() % 26);
+		s = MySTL::string(buf, len);
+	}
+	for (size_t i = 0; i != lookups; ++i)
+		str_queries[i] = (i & 1) ? strs[gen() % n] : MySTL::string("missing key");
+	run<MySTL::string, string_hash>("string", strs, str_queries);
+	return 0;
+}
\ No newline at end of file
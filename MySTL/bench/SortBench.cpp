@@ -0,0 +1,86 @@
+#include "Bench.h"
+#include "Algorithm.h"
+#include "RadixSort.h"
+#include "String.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// sort, stable_sort and radix_sort against std::sort on vector<int>,
+// vector<double> and vector<MySTL::string>, for random, sorted, reverse,
+// organ-pipe and many-duplicates inputs
+namespace{
+	using MySTL::Bench::keep;
+	using MySTL::Bench::report;
+	using MySTL::Bench::time_ms;
+
+	// the keys of every distribution, the element types are built from them
+	std::vector<int> make_keys(const char *shape, size_t n){
+		std::mt19937 gen(42);
+		std::vector<int> keys(n);
+		const std::string s(shape);
+		for (size_t i = 0; i != n; ++i){
+			if (s == "random")
+				keys[i] = (int)(gen() >> 1);
+			else if (s == "sorted")
+				keys[i] = (int)i;
+			else if (s == "reverse")
+				keys[i] = (int)(n - i);
+			else if (s == "organ-pipe")
+				keys[i] = (int)(i < n / 2 ? i : n - i);
+			else//many duplicates
+				keys[i] = (int)(gen() % 16);
+		}
+		return keys;
+	}
+	void make_value(int key, int& value){ value = key; }
+	void make_value(int key, double& value){ value = key + 0.5; }
+	void make_value(int key, MySTL::string& value){
+		char buf[16];
+		std::snprintf(buf, sizeof(buf), "%010d", key);//zero padded, so strings order as the keys do
+		value = MySTL::string(buf);
+	}
+
+	template<class T, class Sort>
+	void run(const char *shape, const char *type, const char *impl, const std::vector<T>& input, Sort sort){
+		std::vector<T> work;
+		report(shape, type, impl, time_ms([&]{ work = input; }, [&]{ sort(work.data(), work.data() + work.size()); }));
+		if (!std::is_sorted(work.begin(), work.end()))
+			std::printf("%s %s %s: not sorted\n", shape, type, impl);
+		keep(work.size());
+	}
+	template<class T>
+	void run_common(const char *shape, const char *type, const std::vector<T>& input){
+		run(shape, type, "std::sort", input, [](T *first, T *last){ std::sort(first, last); });
+		run(shape, type, "MySTL::sort", input, [](T *first, T *last){ MySTL::sort(first, last); });
+		run(shape, type, "MySTL::stable_sort", input, [](T *first, T *last){ MySTL::stable_sort(first, last); });
+	}
+	template<class T>
+	std::vector<T> make_input(const std::vector<int>& keys){
+		std::vector<T> input(keys.size());
+		for (size_t i = 0; i != keys.size(); ++i)
+			make_value(keys[i], input[i]);
+		return input;
+	}
+}
+
+int main(int argc, char *argv[]){
+	size_t n = MySTL::Bench::problem_size(argc, argv, 1000000);
+	const char *shapes[] = { "random", "sorted", "reverse", "organ-pipe", "many-duplicates" };
+	for (auto shape : shapes){
+		auto keys = make_keys(shape, n);
+		auto ints = make_input<int>(keys);
+		run_common(shape, "vector<int>", ints);
+		run(shape, "vector<int>", "MySTL::radix_sort", ints, [](int *first, int *last){ MySTL::radix_sort(first, last); });
+		auto doubles = make_input<double>(keys);
+		run_common(shape, "vector<double>", doubles);
+		run(shape, "vector<double>", "MySTL::radix_sort", doubles, [](double *first, double *last){ MySTL::radix_sort(first, last); });
+		auto strings = make_input<MySTL::string>(keys);
+		run_common(shape, "vector<string>", strings);
+		run(shape, "vector<string>", "MySTL::msd_radix_sort", strings,
+			[](MySTL::string *first, MySTL::string *last){ MySTL::msd_radix_sort(first, last); });
+	}
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#include "Bench.h"
+#include "BinarySearchTree.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+// binary_search_tree unbalanced and as a treap (balanced = true), fed with sorted
+// and with shuffled keys from 1K up to 1M by default: inserting every key, then
+// finding every key once; sorted input makes the unbalanced tree a list, so it is
+// only run up to UNBALANCED_SORTED_MAX keys, at 1M its quadratic insert would take
+// most of an hour and recurse as deep as the tree
+namespace{
+	using MySTL::Bench::keep;
+	using MySTL::Bench::report;
+	using MySTL::Bench::time_ms;
+
+	const size_t UNBALANCED_SORTED_MAX = 1 << 14;
+
+	void run(const char *shape, const char *input, bool balanced, const std::vector<int>& keys){
+		char op[32];
+		const char *impl = balanced ? "treap" : "unbalanced";
+		std::unique_ptr<MySTL::binary_search_tree<int>> t;
+		std::snprintf(op, sizeof(op), "insert %s", input);
+		report(shape, op, impl, time_ms([&]{ t.reset(); }, [&]{
+			t.reset(new MySTL::binary_search_tree<int>(balanced));
+			for (auto k : keys)
+				t->insert(k);
+			keep(t->size());
+		}, 1));
+		std::snprintf(op, sizeof(op), "find all, %s", input);
+		report(shape, op, impl, time_ms([&]{
+			size_t hits = 0;
+			for (auto k : keys)
+				hits += (t->find(k) != t->cend());
+			keep(hits);
+		}));
+		std::printf("%-16s %-22s %-26s %10zu height\n", shape, input, impl, t->height());
+	}
+}
+
+int main(int argc, char *argv[]){
+	const size_t largest = MySTL::Bench::problem_size(argc, argv, 1000000);
+	std::mt19937 gen(42);
+	char shape[32];
+	for (size_t n = std::min((size_t)1 << 10, largest);; n = std::min(n << 2, largest)){
+		std::snprintf(shape, sizeof(shape), "n=%zu", n);
+		std::vector<int> sorted(n);
+		for (size_t i = 0; i != n; ++i)
+			sorted[i] = (int)i;
+		auto shuffled = sorted;
+		std::shuffle(shuffled.begin(), shuffled.end(), gen);
+		if (n <= UNBALANCED_SORTED_MAX)
+			run(shape, "sorted", false, sorted);
+		run(shape, "sorted", true, sorted);
+		run(shape, "shuffled", false, shuffled);
+		run(shape, "shuffled", true, shuffled);
+		if (n == largest)
+			break;
+	}
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include "Bench.h"
+#include "AVLTree.h"
+#include "NodePool.h"
+
+#include <random>
+#include <vector>
+
+// avl_tree of 10M random ints by default with heap_node_storage and with
+// pooled_node_storage, before and after compact(): an in-order walk of the whole
+// tree and 1M finds, the tree is filled in random order so that the heap
+// nodes end up scattered against the order of the values
+namespace{
+	using MySTL::Bench::keep;
+	using MySTL::Bench::report;
+	using MySTL::Bench::time_ms;
+
+	template<class Tree>
+	void measure(const char *shape, const char *impl, const Tree& t, const std::vector<int>& queries){
+		report(shape, "in-order walk", impl, time_ms([&]{
+			size_t sum = 0;
+			for (auto it = t.cbegin(); it != t.cend(); ++it)
+				sum += *it;
+			keep(sum);
+		}));
+		report(shape, "1M find", impl, time_ms([&]{
+			size_t hits = 0;
+			for (auto q : queries)
+				hits += (t.find(q) != t.cend());
+			keep(hits);
+		}));
+	}
+}
+
+int main(int argc, char *argv[]){
+	const size_t n = MySTL::Bench::problem_size(argc, argv, 10000000);
+	std::mt19937 gen(42);
+	std::vector<int> keys(n), queries(1000000);
+	for (auto& k : keys)
+		k = (int)(gen() >> 1);
+	for (auto& q : queries)
+		q = keys[gen() % n];
+	char shape[32];
+	std::snprintf(shape, sizeof(shape), "n=%zu", n);
+	{
+		MySTL::avl_tree<int, MySTL::less<int>, MySTL::heap_node_storage> t;
+		for (auto k : keys)
+			t.insert(k);
+		measure(shape, "heap nodes", t, queries);
+	}
+	{
+		MySTL::avl_tree<int, MySTL::less<int>, MySTL::pooled_node_storage> t;
+		for (auto k : keys)
+			t.insert(k);
+		measure(shape, "pooled nodes", t, queries);
+		report(shape, "compact", "pooled nodes", time_ms([&]{ t.compact(); }, 1));
+		measure(shape, "pooled nodes, compacted", t, queries);
+	}
+	return 0;
+}
\ No newline at end of file
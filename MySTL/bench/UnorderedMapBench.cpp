@@ -0,0 +1,86 @@
+#include "Bench.h"
+#include "Unordered_map.h"
+
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// MySTL::Unordered_map against std::unordered_map on int, random 64-bit and
+// short string keys, needs C++17 for std's try_emplace and insert_or_assign
+namespace{
+	using MySTL::Bench::keep;
+	using MySTL::Bench::report;
+	using MySTL::Bench::time_ms;
+
+	template<class Map, class Key>
+	void run(const char *shape, const char *impl, const std::vector<Key>& keys, const std::vector<Key>& misses){
+		report(shape, "operator[]", impl, time_ms([&]{
+			Map m(16);
+			for (auto& k : keys)
+				++m[k];
+			keep(m.size());
+		}));
+		report(shape, "try_emplace", impl, time_ms([&]{
+			Map m(16);
+			for (auto& k : keys)
+				m.try_emplace(k, 1);
+			keep(m.size());
+		}));
+		Map m(16);
+		for (auto& k : keys)
+			m.insert_or_assign(k, 1);
+		report(shape, "insert_or_assign", impl, time_ms([&]{
+			for (auto& k : keys)
+				m.insert_or_assign(k, 2);
+			keep(m.size());
+		}));
+		report(shape, "find hit", impl, time_ms([&]{
+			size_t found = 0;
+			for (auto& k : keys)
+				found += (m.find(k) != m.end());
+			keep(found);
+		}));
+		report(shape, "find miss", impl, time_ms([&]{
+			size_t found = 0;
+			for (auto& k : misses)
+				found += (m.find(k) != m.end());
+			keep(found);
+		}));
+	}
+	template<class Key>
+	void run_both(const char *shape, const std::vector<Key>& keys, const std::vector<Key>& misses){
+		run<std::unordered_map<Key, int>>(shape, "std::unordered_map", keys, misses);
+		run<MySTL::Unordered_map<Key, int>>(shape, "MySTL::Unordered_map", keys, misses);
+		run<MySTL::Unordered_map<Key, int, std::hash<Key>, MySTL::equal_to<Key>,
+			MySTL::allocator<MySTL::pair<Key, int>>, MySTL::power2_bucket_policy>>(shape, "MySTL::Unordered_map/pow2", keys, misses);
+	}
+}
+
+int main(int argc, char *argv[]){
+	size_t n = MySTL::Bench::problem_size(argc, argv, 1000000);
+	std::mt19937_64 gen(42);
+
+	std::vector<int> ints(n), int_misses(n);
+	for (size_t i = 0; i != n; ++i){
+		ints[i] = (int)i;
+		int_misses[i] = (int)(n + i);
+	}
+	std::shuffle(ints.begin(), ints.end(), gen);
+	run_both("int", ints, int_misses);
+
+	std::vector<unsigned long long> u64(n), u64_misses(n);
+	for (size_t i = 0; i != n; ++i){
+		u64[i] = gen() | 1;//odd hits, even misses
+		u64_misses[i] = gen() & ~1ull;
+	}
+	run_both("u64", u64, u64_misses);
+
+	std::vector<std::string> strs(n), str_misses(n);
+	for (size_t i = 0; i != n; ++i){
+		strs[i] = "key:" + std::to_string(gen());
+		str_misses[i] = "miss:" + std::to_string(gen());
+	}
+	run_both("string", strs, str_misses);
+	return 0;
+}
\ No newline at end of file